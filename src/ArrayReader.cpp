@@ -1,3 +1,4 @@
+#include <vector>
 #include <memory>
 #include <unordered_map>
 #include <iostream>
@@ -12,6 +13,7 @@
 
 #include "ArrayReader.h"
 #include "ArrayWriter.h"
+#include "BitmapKernels.h"
 #include "DatatypeStore.h"
 #include "HelperFunctions.h"
 #include "TypeCheck.h"
@@ -24,38 +26,113 @@ namespace {
 typedef K(*ReadArrayCommon)(std::shared_ptr<arrow::Array> array_data, TypeMappingOverride& type_overrides);
 typedef void(*AppendArrayCommon)(std::shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides);
 
+// Width in bytes of each item of a simple kdb list
+size_t KdbTypeWidth(KdbType type)
+{
+  switch (type) {
+  case KB:
+  case KG:
+  case KC:
+    return 1;
+  case KH:
+    return 2;
+  case KI:
+  case KE:
+  case KM:
+  case KD:
+  case KU:
+  case KV:
+  case KT:
+    return 4;
+  case UU:
+    return 16;
+  default:
+    return 8; // KJ, KF, KS, KP, KZ, KN
+  }
+}
+
+// Converts the child values of a list or map array into one kdb sub-list per
+// parent row, stored in result.  The child handler is resolved and run once
+// over the whole range of child values, then each row's values are copied
+// (simple lists) or moved (mixed lists) into its own sub-list by walking the
+// offsets.  Children which kdb represents column-wise (struct, union and
+// dictionary) can't be split that way so are still converted a slice per row.
+template <typename ListArrayType>
+void ReadChildLists(const ListArrayType& list_array, shared_ptr<arrow::Array> values, K* result, TypeMappingOverride& type_overrides, GetKdbTypeCommon get_kdb_type, AppendArrayCommon append_array)
+{
+  auto length = list_array.length();
+  if (!length)
+    return;
+
+  auto value_type = values->type();
+  switch (value_type->id()) {
+  case arrow::Type::STRUCT:
+  case arrow::Type::SPARSE_UNION:
+  case arrow::Type::DENSE_UNION:
+  case arrow::Type::DICTIONARY:
+    for (auto i = 0; i < length; ++i) {
+      auto value_slice = values->Slice(list_array.value_offset(i), list_array.value_length(i));
+      K k_sub = kx::arrowkdb::InitKdbForArray(value_type, value_slice->length(), type_overrides, get_kdb_type);
+      size_t sub_index = 0;
+      append_array(value_slice, k_sub, sub_index, type_overrides);
+      result[i] = k_sub;
+    }
+    return;
+  default:
+    break;
+  }
+
+  int64_t first = list_array.value_offset(0);
+  int64_t total_length = list_array.value_offset(length) - first;
+  K k_values = kx::arrowkdb::InitKdbForArray(value_type, total_length, type_overrides, get_kdb_type);
+  size_t values_index = 0;
+  append_array(values->Slice(first, total_length), k_values, values_index, type_overrides);
+
+  if (k_values->t == 0) {
+    // Move the child objects into each sub-list then free the container only
+    for (auto i = 0; i < length; ++i) {
+      auto value_length = list_array.value_length(i);
+      K k_sub = ktn(0, value_length);
+      memcpy(kK(k_sub), kK(k_values) + list_array.value_offset(i) - first, value_length * sizeof(K));
+      result[i] = k_sub;
+    }
+    k_values->n = 0;
+  } else {
+    auto width = KdbTypeWidth(k_values->t);
+    for (auto i = 0; i < length; ++i) {
+      auto value_length = list_array.value_length(i);
+      K k_sub = ktn(k_values->t, value_length);
+      memcpy(kG(k_sub), kG(k_values) + (list_array.value_offset(i) - first) * width, value_length * width);
+      result[i] = k_sub;
+    }
+  }
+  r0(k_values);
+}
+
 // An arrow list array is a nested set of child lists.  This is represented in
 // kdb as a mixed list for the parent list array containing a set of sub-lists,
 // one for each of the list value sets.
 template <typename ListArrayType>
-void AppendList(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides, ReadArrayCommon read_array)
+void AppendList(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides, GetKdbTypeCommon get_kdb_type, AppendArrayCommon append_array)
 {
-  for (auto i = 0; i < array_data->length(); ++i) {
-    // Slice the parent array to get the list value set at the specified index
-    auto value_slice = static_pointer_cast<ListArrayType>(array_data)->value_slice(i);
-
-    // Recursively populate the kdb parent mixed list from that slice
-    kK(k_array)[index++] = read_array(value_slice, type_overrides);
-  }
+  auto list_array = static_pointer_cast<ListArrayType>(array_data);
+  ReadChildLists(*list_array, list_array->values(), &kK(k_array)[index], type_overrides, get_kdb_type, append_array);
+  index += list_array->length();
 }
 
 // An arrow map array is a nested set of key/item paired child arrays.  This is
 // represented in kdb as a mixed list for the parent map array, with a
 // dictionary for each map value set.
-void AppendMap(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides, ReadArrayCommon read_array)
+void AppendMap(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides, GetKdbTypeCommon get_kdb_type, AppendArrayCommon append_array)
 {
   auto map_array = static_pointer_cast<arrow::MapArray>(array_data);
-  auto keys = map_array->keys();
-  auto items = map_array->items();
-  for (auto i = 0; i < array_data->length(); ++i) {
-    // Slice the parent key/items arrays to get the map value set child list at
-    // the specified index
-    auto keys_slice = keys->Slice(map_array->value_offset(i), map_array->value_length(i));
-    auto items_slice = items->Slice(map_array->value_offset(i), map_array->value_length(i));
-    // Recursively populate the kdb parent mixed list with a dictionary
-    // populated from those slices
-    kK(k_array)[index++] = xD(read_array(keys_slice, type_overrides), read_array(items_slice, type_overrides));
-  }
+  auto length = map_array->length();
+  std::vector<K> keys(length);
+  std::vector<K> items(length);
+  ReadChildLists(*map_array, map_array->keys(), keys.data(), type_overrides, get_kdb_type, append_array);
+  ReadChildLists(*map_array, map_array->items(), items.data(), type_overrides, get_kdb_type, append_array);
+  for (auto i = 0; i < length; ++i)
+    kK(k_array)[index++] = xD(keys[i], items[i]);
 }
 
 // An arrow struct array is a logical grouping of child arrays with each child
@@ -117,6 +194,264 @@ void AppendDictionary(shared_ptr<arrow::Array> array_data, K k_array, size_t& in
   jv(&kK(k_array)[1], indices);
 }
 
+// Returns the symbol used for a null string, being either the interned string
+// null mapping or the null symbol
+S GetNullSymbol(bool have_null_mapping, const std::string& null_mapping)
+{
+  if (have_null_mapping)
+    return sn((S)null_mapping.data(), static_cast<I>(null_mapping.length()));
+  else
+    return ss((S)"");
+}
+
+// Interns each string in an arrow string or large_string array as a kdb symbol
+template<typename StringArrayType>
+void AppendSymbols(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, bool have_null_mapping, const std::string& null_mapping)
+{
+  auto str_array = static_pointer_cast<StringArrayType>(array_data);
+  S null_symbol = GetNullSymbol(have_null_mapping, null_mapping);
+  auto length = str_array->length();
+  for (auto i = 0; i < length; ++i) {
+    if (str_array->IsNull(i)) {
+      kS(k_array)[index++] = null_symbol;
+    } else {
+      auto str_data = str_array->GetView(i);
+      kS(k_array)[index++] = sn((S)str_data.data(), static_cast<I>(str_data.length()));
+    }
+  }
+}
+
+// Copies each value of an arrow string or binary array into a kdb char or byte
+// list, reading the offsets and value data buffers directly rather than
+// through a std::string per value
+template<typename BinaryArrayType, typename NullType>
+void AppendBinaries(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, KdbType kdb_type, bool have_null_mapping, const NullType& null_mapping)
+{
+  auto bin_array = static_pointer_cast<BinaryArrayType>(array_data);
+  auto offsets = bin_array->raw_value_offsets();
+  auto data = bin_array->raw_data();
+  auto length = bin_array->length();
+  auto map_nulls = have_null_mapping && bin_array->null_count();
+  for (auto i = 0; i < length; ++i) {
+    K k_bin = nullptr;
+    if (map_nulls && bin_array->IsNull(i)) {
+      k_bin = ktn(kdb_type, null_mapping.length());
+      memcpy(kG(k_bin), null_mapping.data(), null_mapping.length());
+    } else {
+      auto value_length = offsets[i + 1] - offsets[i];
+      k_bin = ktn(kdb_type, value_length);
+      memcpy(kG(k_bin), data + offsets[i], value_length);
+    }
+    kK(k_array)[index++] = k_bin;
+  }
+}
+
+// Reads a chunked array of strings into the flat form used by STRINGS_AS_FLAT:
+// a single char list of all the strings concatenated plus a long list of
+// length+1 offsets into it, so string i is chars[offsets[i]+til offsets[i+1]-offsets[i]].
+// Chunks without nulls to map are copied with a single memcpy.
+template<typename StringArrayType>
+K ReadFlatStrings(shared_ptr<arrow::ChunkedArray> chunked_array, bool have_null_mapping, const std::string& null_mapping)
+{
+  int64_t total_length = 0;
+  for (auto j = 0; j < chunked_array->num_chunks(); ++j) {
+    auto str_array = static_pointer_cast<StringArrayType>(chunked_array->chunk(j));
+    auto offsets = str_array->raw_value_offsets();
+    auto length = str_array->length();
+    if (!length)
+      continue;
+    if (have_null_mapping && str_array->null_count()) {
+      for (auto i = 0; i < length; ++i)
+        total_length += str_array->IsNull(i) ? null_mapping.length() : offsets[i + 1] - offsets[i];
+    } else {
+      total_length += offsets[length] - offsets[0];
+    }
+  }
+
+  K k_chars = ktn(KC, total_length);
+  K k_offsets = ktn(KJ, chunked_array->length() + 1);
+  int64_t position = 0;
+  size_t index = 0;
+  kJ(k_offsets)[index++] = 0;
+  for (auto j = 0; j < chunked_array->num_chunks(); ++j) {
+    auto str_array = static_pointer_cast<StringArrayType>(chunked_array->chunk(j));
+    auto offsets = str_array->raw_value_offsets();
+    auto data = str_array->raw_data();
+    auto length = str_array->length();
+    if (!length)
+      continue;
+    if (have_null_mapping && str_array->null_count()) {
+      for (auto i = 0; i < length; ++i) {
+        if (str_array->IsNull(i)) {
+          memcpy(kG(k_chars) + position, null_mapping.data(), null_mapping.length());
+          position += null_mapping.length();
+        } else {
+          auto value_length = offsets[i + 1] - offsets[i];
+          memcpy(kG(k_chars) + position, data + offsets[i], value_length);
+          position += value_length;
+        }
+        kJ(k_offsets)[index++] = position;
+      }
+    } else {
+      memcpy(kG(k_chars) + position, data + offsets[0], offsets[length] - offsets[0]);
+      for (auto i = 1; i <= length; ++i)
+        kJ(k_offsets)[index++] = position + offsets[i] - offsets[0];
+      position += offsets[length] - offsets[0];
+    }
+  }
+
+  return knk(2, k_chars, k_offsets);
+}
+
+// Whether a top level column is read into the STRINGS_AS_FLAT form.  Symbols
+// take precedence if STRINGS_AS_SYMBOLS is also set.
+bool IsFlatStrings(shared_ptr<arrow::DataType> datatype, TypeMappingOverride& type_overrides)
+{
+  return type_overrides.strings_as_flat && !type_overrides.strings_as_symbols
+    && (datatype->id() == arrow::Type::STRING || datatype->id() == arrow::Type::LARGE_STRING);
+}
+
+K ReadFlatStrings(shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappingOverride& type_overrides)
+{
+  if (chunked_array->type()->id() == arrow::Type::STRING)
+    return ReadFlatStrings<arrow::StringArray>(chunked_array, type_overrides.null_mapping.have_string, type_overrides.null_mapping.string_null);
+  else
+    return ReadFlatStrings<arrow::LargeStringArray>(chunked_array, type_overrides.null_mapping.have_large_string, type_overrides.null_mapping.large_string_null);
+}
+
+// Reads a chunked array of lists into the flat form used by LIST_AS_FLAT: a
+// single kdb list of all the child values plus a long list of length+1 offsets
+// into it.  The child values of each chunk are appended in one go from a
+// single slice rather than one slice per list.
+template<typename ListArrayType>
+K ReadFlatList(shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappingOverride& type_overrides)
+{
+  int64_t total_length = 0;
+  for (auto j = 0; j < chunked_array->num_chunks(); ++j) {
+    auto list_array = static_pointer_cast<ListArrayType>(chunked_array->chunk(j));
+    auto length = list_array->length();
+    if (length)
+      total_length += list_array->value_offset(length) - list_array->value_offset(0);
+  }
+
+  auto value_type = chunked_array->type()->field(0)->type();
+  K k_values = kx::arrowkdb::InitKdbForArray(value_type, total_length, type_overrides, kx::arrowkdb::GetKdbType);
+  K k_offsets = ktn(KJ, chunked_array->length() + 1);
+  size_t index = 0;
+  size_t offsets_index = 0;
+  kJ(k_offsets)[offsets_index++] = 0;
+  for (auto j = 0; j < chunked_array->num_chunks(); ++j) {
+    auto list_array = static_pointer_cast<ListArrayType>(chunked_array->chunk(j));
+    auto length = list_array->length();
+    if (!length)
+      continue;
+    int64_t first = list_array->value_offset(0);
+    int64_t base = index;
+    for (auto i = 1; i <= length; ++i)
+      kJ(k_offsets)[offsets_index++] = base + list_array->value_offset(i) - first;
+    auto values = list_array->values()->Slice(first, list_array->value_offset(length) - first);
+    kx::arrowkdb::AppendArray(values, k_values, index, type_overrides);
+  }
+
+  return knk(2, k_values, k_offsets);
+}
+
+// Whether a top level column is read into the LIST_AS_FLAT form.  Only lists
+// whose child values map to a simple kdb list are flattened.
+bool IsFlatList(shared_ptr<arrow::DataType> datatype, TypeMappingOverride& type_overrides)
+{
+  if (!type_overrides.list_as_flat)
+    return false;
+  switch (datatype->id()) {
+  case arrow::Type::LIST:
+  case arrow::Type::LARGE_LIST:
+  case arrow::Type::FIXED_SIZE_LIST:
+    return GetKdbType(datatype->field(0)->type(), type_overrides) > 0;
+  default:
+    return false;
+  }
+}
+
+K ReadFlatList(shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappingOverride& type_overrides)
+{
+  switch (chunked_array->type()->id()) {
+  case arrow::Type::LIST:
+    return ReadFlatList<arrow::ListArray>(chunked_array, type_overrides);
+  case arrow::Type::LARGE_LIST:
+    return ReadFlatList<arrow::LargeListArray>(chunked_array, type_overrides);
+  default:
+    return ReadFlatList<arrow::FixedSizeListArray>(chunked_array, type_overrides);
+  }
+}
+
+// Whether a top level column is read into one of the flat forms
+bool IsFlatColumn(shared_ptr<arrow::DataType> datatype, TypeMappingOverride& type_overrides)
+{
+  return IsFlatStrings(datatype, type_overrides) || IsFlatList(datatype, type_overrides);
+}
+
+K ReadFlatColumn(shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappingOverride& type_overrides)
+{
+  if (IsFlatStrings(chunked_array->type(), type_overrides))
+    return ReadFlatStrings(chunked_array, type_overrides);
+  else
+    return ReadFlatList(chunked_array, type_overrides);
+}
+
+// A dictionary array of strings is mapped to a symbol list by interning each
+// distinct dictionary entry once then looking up the symbol for every index
+template<typename StringArrayType>
+void AppendSymbolDictionary(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, bool have_null_mapping, const std::string& null_mapping)
+{
+  auto dictionary_array = static_pointer_cast<arrow::DictionaryArray>(array_data);
+  auto dictionary = static_pointer_cast<StringArrayType>(dictionary_array->dictionary());
+  S null_symbol = GetNullSymbol(have_null_mapping, null_mapping);
+  std::vector<S> symbols;
+  symbols.reserve(dictionary->length());
+  for (auto j = 0; j < dictionary->length(); ++j) {
+    if (dictionary->IsNull(j)) {
+      symbols.push_back(null_symbol);
+    } else {
+      auto str_data = dictionary->GetView(j);
+      symbols.push_back(sn((S)str_data.data(), static_cast<I>(str_data.length())));
+    }
+  }
+
+  auto length = dictionary_array->length();
+  for (auto i = 0; i < length; ++i) {
+    if (dictionary_array->IsNull(i))
+      kS(k_array)[index++] = null_symbol;
+    else
+      kS(k_array)[index++] = symbols[dictionary_array->GetValueIndex(i)];
+  }
+}
+
+// Whether a dictionary datatype is converted to a symbol list rather than the
+// mixed list of values and indicies
+bool IsSymbolDictionary(shared_ptr<arrow::DataType> datatype, TypeMappingOverride& type_overrides)
+{
+  auto value_type = static_pointer_cast<arrow::DictionaryType>(datatype)->value_type();
+  return type_overrides.strings_as_symbols && (value_type->id() == arrow::Type::STRING || value_type->id() == arrow::Type::LARGE_STRING);
+}
+
+// Copies the values of a fixed width primitive array into a kdb list of the
+// same width.  Arrays without nulls, or without a null mapping for the type,
+// are copied in one go.  Otherwise the validity bitmap is walked a word at a
+// time so that runs of valid values are still bulk copied and null values are
+// replaced with the null mapping.
+template<typename ArrayType, typename T>
+void AppendPrimitiveArray(shared_ptr<arrow::Array> array_data, T* result, bool have_null, T null_value)
+{
+  static_assert( sizeof( typename ArrayType::value_type ) == sizeof( T ), "Mismatched arrow and kdb widths" );
+  auto typed_array = static_pointer_cast<ArrayType>(array_data);
+  auto length = typed_array->length();
+  auto values = reinterpret_cast<const T*>( typed_array->raw_values() );
+  if( have_null && typed_array->null_count() )
+    CopyWithNullMapping<T>( typed_array->null_bitmap_data(), typed_array->offset(), length, values, null_value, result );
+  else
+    memcpy( result, values, length * sizeof( T ) );
+}
+
 template<arrow::Type::type TypeId>
 void AppendArray(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides);
 
@@ -132,276 +467,137 @@ template<>
 void AppendArray<arrow::Type::BOOL>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
   auto bool_array = static_pointer_cast<arrow::BooleanArray>(array_data);
-  // BooleanArray doesn't have a bulk reader since arrow BooleanType is only 1 bit
-  for (auto i = 0; i < bool_array->length(); ++i){
-    kG(k_array)[index++] = // preventing branch prediction failures
-        ( ( type_overrides.null_mapping.have_boolean && bool_array->IsNull( i ) ) * type_overrides.null_mapping.boolean_null )
-        + ( !( type_overrides.null_mapping.have_boolean && bool_array->IsNull( i ) ) * bool_array->Value( i ) );
-  }
+  auto length = bool_array->length();
+  // BooleanArray values are a bitmap like the validity, so both are unpacked a
+  // word at a time
+  const uint8_t* validity = nullptr;
+  if( type_overrides.null_mapping.have_boolean && bool_array->null_count() )
+    validity = bool_array->null_bitmap_data();
+  UnpackBooleans( bool_array->values()->data(), bool_array->offset(), validity, bool_array->offset(), length,
+    type_overrides.null_mapping.boolean_null, ( uint8_t* )&kG( k_array )[index] );
+  index += length;
 }
 
 template<>
 void AppendArray<arrow::Type::UINT8>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto uint8_array = static_pointer_cast<arrow::UInt8Array>(array_data);
-  auto length = uint8_array->length();
-  if( type_overrides.null_mapping.have_uint8 && uint8_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kG( k_array )[i] = ( uint8_array->IsNull( i ) * type_overrides.null_mapping.uint8_null )
-        + ( !uint8_array->IsNull( i ) * uint8_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kG( k_array )[index], uint8_array->raw_values(), length * sizeof( arrow::UInt8Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::UInt8Array, uint8_t>( array_data, ( uint8_t* )&kG( k_array )[index],
+    type_overrides.null_mapping.have_uint8, ( uint8_t )type_overrides.null_mapping.uint8_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::INT8>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto int8_array = static_pointer_cast<arrow::Int8Array>(array_data);
-  auto length = int8_array->length();
-  if( type_overrides.null_mapping.have_int8 && int8_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kG( k_array )[i] = ( int8_array->IsNull( i ) * type_overrides.null_mapping.int8_null )
-        + ( !int8_array->IsNull( i ) * int8_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kG( k_array )[index], int8_array->raw_values(), length * sizeof( arrow::Int8Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::Int8Array, uint8_t>( array_data, ( uint8_t* )&kG( k_array )[index],
+    type_overrides.null_mapping.have_int8, ( uint8_t )type_overrides.null_mapping.int8_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::UINT16>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto uint16_array = static_pointer_cast<arrow::UInt16Array>(array_data);
-  auto length = uint16_array->length();
-  if( type_overrides.null_mapping.have_uint16 && uint16_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kH( k_array )[i] = ( uint16_array->IsNull( i ) * type_overrides.null_mapping.uint16_null )
-        + ( !uint16_array->IsNull( i ) * uint16_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kH( k_array )[index], uint16_array->raw_values(), length * sizeof( arrow::UInt16Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::UInt16Array, int16_t>( array_data, ( int16_t* )&kH( k_array )[index],
+    type_overrides.null_mapping.have_uint16, ( int16_t )type_overrides.null_mapping.uint16_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::INT16>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto int16_array = static_pointer_cast<arrow::Int16Array>(array_data);
-  auto length = int16_array->length();
-  if( type_overrides.null_mapping.have_int16 && int16_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kH( k_array )[i] = ( int16_array->IsNull( i ) * type_overrides.null_mapping.int16_null )
-        + ( !int16_array->IsNull( i ) * int16_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kH( k_array )[index], int16_array->raw_values(), length * sizeof( arrow::Int16Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::Int16Array, int16_t>( array_data, ( int16_t* )&kH( k_array )[index],
+    type_overrides.null_mapping.have_int16, ( int16_t )type_overrides.null_mapping.int16_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::UINT32>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto uint32_array = static_pointer_cast<arrow::UInt32Array>(array_data);
-  auto length = uint32_array->length();
-  if( type_overrides.null_mapping.have_uint32 && uint32_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kI( k_array )[i] = ( uint32_array->IsNull( i ) * type_overrides.null_mapping.uint32_null )
-        + ( !uint32_array->IsNull( i ) * uint32_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kI( k_array )[index], uint32_array->raw_values(), length * sizeof( arrow::UInt32Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::UInt32Array, int32_t>( array_data, ( int32_t* )&kI( k_array )[index],
+    type_overrides.null_mapping.have_uint32, ( int32_t )type_overrides.null_mapping.uint32_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::INT32>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto int32_array = static_pointer_cast<arrow::Int32Array>(array_data);
-  auto length = int32_array->length();
-  if( type_overrides.null_mapping.have_int32 && int32_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kI( k_array )[i] = ( int32_array->IsNull( i ) * type_overrides.null_mapping.int32_null )
-        + (!int32_array->IsNull( i ) * int32_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kI( k_array )[index], int32_array->raw_values(), length * sizeof( arrow::Int32Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::Int32Array, int32_t>( array_data, ( int32_t* )&kI( k_array )[index],
+    type_overrides.null_mapping.have_int32, ( int32_t )type_overrides.null_mapping.int32_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::UINT64>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto uint64_array = static_pointer_cast<arrow::UInt64Array>(array_data);
-  auto length = uint64_array->length();
-  if( type_overrides.null_mapping.have_uint64 && uint64_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kJ( k_array )[i] = ( uint64_array->IsNull( i ) * type_overrides.null_mapping.uint64_null )
-        + ( !uint64_array->IsNull( i ) * uint64_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kJ( k_array )[index], uint64_array->raw_values(), length * sizeof( arrow::UInt64Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::UInt64Array, int64_t>( array_data, ( int64_t* )&kJ( k_array )[index],
+    type_overrides.null_mapping.have_uint64, ( int64_t )type_overrides.null_mapping.uint64_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::INT64>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto int64_array = static_pointer_cast<arrow::Int64Array>(array_data);
-  auto length = int64_array->length();
-  if( type_overrides.null_mapping.have_int64 && int64_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kJ( k_array )[i] = ( int64_array->IsNull( i ) * type_overrides.null_mapping.int64_null )
-        + (!int64_array->IsNull( i ) * int64_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kJ( k_array )[index], int64_array->raw_values(), length * sizeof( arrow::Int64Array::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::Int64Array, int64_t>( array_data, ( int64_t* )&kJ( k_array )[index],
+    type_overrides.null_mapping.have_int64, ( int64_t )type_overrides.null_mapping.int64_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::HALF_FLOAT>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto hfl_array = static_pointer_cast<arrow::HalfFloatArray>(array_data);
-  auto length = hfl_array->length();
-  if( type_overrides.null_mapping.have_float16 && hfl_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kH( k_array )[i] = ( hfl_array->IsNull( i ) ? type_overrides.null_mapping.float16_null : hfl_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kH( k_array )[index], hfl_array->raw_values(), length * sizeof( arrow::HalfFloatArray::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::HalfFloatArray, int16_t>( array_data, ( int16_t* )&kH( k_array )[index],
+    type_overrides.null_mapping.have_float16, ( int16_t )type_overrides.null_mapping.float16_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::FLOAT>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto fl_array = static_pointer_cast<arrow::FloatArray>(array_data);
-  auto length = fl_array->length();
-  if( type_overrides.null_mapping.have_float32 && fl_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kE( k_array )[i] = ( fl_array->IsNull( i ) ? type_overrides.null_mapping.float32_null : fl_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kE( k_array )[index], fl_array->raw_values(), length * sizeof( arrow::FloatArray::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::FloatArray, float>( array_data, ( float* )&kE( k_array )[index],
+    type_overrides.null_mapping.have_float32, ( float )type_overrides.null_mapping.float32_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::DOUBLE>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto dbl_array = static_pointer_cast<arrow::DoubleArray>(array_data);
-  auto length = dbl_array->length();
-  if( type_overrides.null_mapping.have_float64 && dbl_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kF( k_array )[i] = ( dbl_array->IsNull( i ) ? type_overrides.null_mapping.float64_null : dbl_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kF( k_array )[index], dbl_array->raw_values(), length * sizeof( arrow::DoubleArray::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::DoubleArray, double>( array_data, ( double* )&kF( k_array )[index],
+    type_overrides.null_mapping.have_float64, ( double )type_overrides.null_mapping.float64_null );
+  index += array_data->length();
 }
 
 template<>
 void AppendArray<arrow::Type::STRING>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto str_array = static_pointer_cast<arrow::StringArray>(array_data);
-  auto length = str_array->length();
-  for( auto i = 0; i < length; ++i ){
-    K k_str = nullptr;
-    if( type_overrides.null_mapping.have_string && str_array->IsNull( i ) ){
-      k_str = ktn( KC, type_overrides.null_mapping.string_null.length() );
-      memcpy( kG( k_str ), type_overrides.null_mapping.string_null.data(), type_overrides.null_mapping.string_null.length() );
-    }
-    else{
-      auto str_data = str_array->GetString(i);
-      k_str = ktn(KC, str_data.length());
-      memcpy(kG( k_str ), str_data.data(), str_data.length());
-    }
-    kK( k_array )[index++] = k_str;
+  if (k_array->t == KS) {
+    AppendSymbols<arrow::StringArray>(array_data, k_array, index, type_overrides.null_mapping.have_string, type_overrides.null_mapping.string_null);
+    return;
   }
+
+  AppendBinaries<arrow::StringArray>(array_data, k_array, index, KC, type_overrides.null_mapping.have_string, type_overrides.null_mapping.string_null);
 }
 
 template<>
 void AppendArray<arrow::Type::LARGE_STRING>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto str_array = static_pointer_cast<arrow::LargeStringArray>(array_data);
-  auto length = str_array->length();
-  for( auto i = 0; i < length; ++i ){
-    K k_str = nullptr;
-    if( type_overrides.null_mapping.have_large_string && str_array->IsNull( i ) ){
-      k_str = ktn( KC, type_overrides.null_mapping.large_string_null.length() );
-      memcpy( kG( k_str ), type_overrides.null_mapping.large_string_null.data(), type_overrides.null_mapping.large_string_null.length() );
-    }
-    else{
-      auto str_data = str_array->GetString(i);
-      k_str = ktn(KC, str_data.length());
-      memcpy(kG(k_str), str_data.data(), str_data.length());
-    }
-    kK( k_array )[index++] = k_str;
+  if (k_array->t == KS) {
+    AppendSymbols<arrow::LargeStringArray>(array_data, k_array, index, type_overrides.null_mapping.have_large_string, type_overrides.null_mapping.large_string_null);
+    return;
   }
+
+  AppendBinaries<arrow::LargeStringArray>(array_data, k_array, index, KC, type_overrides.null_mapping.have_large_string, type_overrides.null_mapping.large_string_null);
 }
 
 template<>
 void AppendArray<arrow::Type::BINARY>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto bin_array = static_pointer_cast<arrow::BinaryArray>(array_data);
-  auto length = bin_array->length();
-  for( auto i = 0; i < length; ++i ){
-    K k_bin = nullptr;
-    if( type_overrides.null_mapping.have_binary && bin_array->IsNull( i ) ){
-      k_bin = ktn( KG, type_overrides.null_mapping.binary_null.length() );
-      memcpy( kG( k_bin ), type_overrides.null_mapping.binary_null.data(), type_overrides.null_mapping.binary_null.length() );
-    }
-    else{
-      auto bin_data = bin_array->GetString(i);
-      k_bin = ktn(KG, bin_data.length());
-      memcpy(kG(k_bin), bin_data.data(), bin_data.length());
-    }
-    kK(k_array)[index++] = k_bin;
-  }
+  AppendBinaries<arrow::BinaryArray>(array_data, k_array, index, KG, type_overrides.null_mapping.have_binary, type_overrides.null_mapping.binary_null);
 }
 
 template<>
 void AppendArray<arrow::Type::LARGE_BINARY>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto bin_array = static_pointer_cast<arrow::LargeBinaryArray>(array_data);
-  auto length = bin_array->length();
-  for( auto i = 0; i < length; ++i ){
-    K k_bin = nullptr;
-    if( type_overrides.null_mapping.have_large_binary && bin_array->IsNull( i ) ){
-        k_bin = ktn( KG, type_overrides.null_mapping.large_binary_null.length() );
-        memcpy( kG( k_bin ), type_overrides.null_mapping.large_binary_null.data(), type_overrides.null_mapping.large_binary_null.length() );
-      }
-      else{
-        auto bin_data = bin_array->GetString(i);
-        k_bin = ktn(KG, bin_data.length());
-        memcpy(kG(k_bin), bin_data.data(), bin_data.length());
-    }
-    kK(k_array)[index++] = k_bin;
-  }
+  AppendBinaries<arrow::LargeBinaryArray>(array_data, k_array, index, KG, type_overrides.null_mapping.have_large_binary, type_overrides.null_mapping.large_binary_null);
 }
 
 template<>
@@ -409,18 +605,20 @@ void AppendArray<arrow::Type::FIXED_SIZE_BINARY>(shared_ptr<arrow::Array> array_
 {
   auto fixed_bin_array = static_pointer_cast<arrow::FixedSizeBinaryArray>(array_data);
   auto length = fixed_bin_array->length();
+  auto byte_width = fixed_bin_array->byte_width();
+  auto values = fixed_bin_array->raw_values();
+  auto map_nulls = type_overrides.null_mapping.have_fixed_binary && fixed_bin_array->null_count();
   for( auto i = 0; i < length; ++i ){
     K k_bin = nullptr;
-    if( type_overrides.null_mapping.have_fixed_binary && fixed_bin_array->IsNull( i ) ){
+    if( map_nulls && fixed_bin_array->IsNull( i ) ){
       k_bin = ktn( KG, type_overrides.null_mapping.fixed_binary_null.length() );
       memcpy( kG( k_bin ), type_overrides.null_mapping.fixed_binary_null.data(), type_overrides.null_mapping.fixed_binary_null.length() );
     }
     else{
-      auto bin_data = fixed_bin_array->GetString(i);
-      k_bin = ktn(KG, bin_data.length());
-      memcpy(kG(k_bin), bin_data.data(), bin_data.length());
+      k_bin = ktn( KG, byte_width );
+      memcpy( kG( k_bin ), values + i * byte_width, byte_width );
     }
-    kK(k_array)[index++] = k_bin;
+    kK( k_array )[index++] = k_bin;
   }
 }
 
@@ -430,11 +628,12 @@ void AppendArray<arrow::Type::DATE32>(shared_ptr<arrow::Array> array_data, K k_a
   TemporalConversion tc(array_data->type());
   auto d32_array = static_pointer_cast<arrow::Date32Array>(array_data);
   auto length = d32_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kI( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_date32 && d32_array->IsNull( i ) ) * type_overrides.null_mapping.date32_null )
-      + ( !( type_overrides.null_mapping.have_date32 && d32_array->IsNull( i ) ) * tc.ArrowToKdb( d32_array->Value( i ) ) );
+  auto result = ( int32_t* )&kI( k_array )[index];
+  tc.ArrowToKdb( d32_array->raw_values(), length, result );
+  if( type_overrides.null_mapping.have_date32 && d32_array->null_count() ){
+    BlendNullMapping<int32_t>( d32_array->null_bitmap_data(), d32_array->offset(), length, type_overrides.null_mapping.date32_null, result );
   }
+  index += length;
 }
 
 template<>
@@ -443,11 +642,12 @@ void AppendArray<arrow::Type::DATE64>(shared_ptr<arrow::Array> array_data, K k_a
   TemporalConversion tc(array_data->type());
   auto d64_array = static_pointer_cast<arrow::Date64Array>(array_data);
   auto length = d64_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kJ( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_date64 && d64_array->IsNull( i ) ) * type_overrides.null_mapping.date64_null )
-      + ( !( type_overrides.null_mapping.have_date64 && d64_array->IsNull( i ) ) * tc.ArrowToKdb( d64_array->Value( i ) ) );
+  auto result = ( int64_t* )&kJ( k_array )[index];
+  tc.ArrowToKdb( d64_array->raw_values(), length, result );
+  if( type_overrides.null_mapping.have_date64 && d64_array->null_count() ){
+    BlendNullMapping<int64_t>( d64_array->null_bitmap_data(), d64_array->offset(), length, type_overrides.null_mapping.date64_null, result );
   }
+  index += length;
 }
 
 template<>
@@ -455,13 +655,13 @@ void AppendArray<arrow::Type::TIMESTAMP>(shared_ptr<arrow::Array> array_data, K
 {
   TemporalConversion tc(array_data->type());
   auto ts_array = static_pointer_cast<arrow::TimestampArray>(array_data);
-  auto timestamp_type = static_pointer_cast<arrow::TimestampType>(ts_array->type());
   auto length = ts_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kJ( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_timestamp && ts_array->IsNull( i ) ) * type_overrides.null_mapping.timestamp_null )
-      + ( !( type_overrides.null_mapping.have_timestamp && ts_array->IsNull( i ) ) * tc.ArrowToKdb( ts_array->Value( i ) ) );
+  auto result = ( int64_t* )&kJ( k_array )[index];
+  tc.ArrowToKdb( ts_array->raw_values(), length, result );
+  if( type_overrides.null_mapping.have_timestamp && ts_array->null_count() ){
+    BlendNullMapping<int64_t>( ts_array->null_bitmap_data(), ts_array->offset(), length, type_overrides.null_mapping.timestamp_null, result );
   }
+  index += length;
 }
 
 template<>
@@ -469,13 +669,13 @@ void AppendArray<arrow::Type::TIME32>(shared_ptr<arrow::Array> array_data, K k_a
 {
   TemporalConversion tc(array_data->type());
   auto t32_array = static_pointer_cast<arrow::Time32Array>(array_data);
-  auto time32_type = static_pointer_cast<arrow::Time32Type>(t32_array->type());
   auto length = t32_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kI( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_time32 && t32_array->IsNull( i ) ) * type_overrides.null_mapping.time32_null )
-      + ( !( type_overrides.null_mapping.have_time32 && t32_array->IsNull( i ) ) * tc.ArrowToKdb( t32_array->Value( i ) ) );
+  auto result = ( int32_t* )&kI( k_array )[index];
+  tc.ArrowToKdb( t32_array->raw_values(), length, result );
+  if( type_overrides.null_mapping.have_time32 && t32_array->null_count() ){
+    BlendNullMapping<int32_t>( t32_array->null_bitmap_data(), t32_array->offset(), length, type_overrides.null_mapping.time32_null, result );
   }
+  index += length;
 }
 
 template<>
@@ -483,13 +683,13 @@ void AppendArray<arrow::Type::TIME64>(shared_ptr<arrow::Array> array_data, K k_a
 {
   TemporalConversion tc(array_data->type());
   auto t64_array = static_pointer_cast<arrow::Time64Array>(array_data);
-  auto time64_type = static_pointer_cast<arrow::Time64Type>(t64_array->type());
   auto length = t64_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kJ( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_time64 && t64_array->IsNull( i ) ) * type_overrides.null_mapping.time64_null )
-      + ( !( type_overrides.null_mapping.have_time64 && t64_array->IsNull( i ) ) * tc.ArrowToKdb( t64_array->Value( i ) ) );
+  auto result = ( int64_t* )&kJ( k_array )[index];
+  tc.ArrowToKdb( t64_array->raw_values(), length, result );
+  if( type_overrides.null_mapping.have_time64 && t64_array->null_count() ){
+    BlendNullMapping<int64_t>( t64_array->null_bitmap_data(), t64_array->offset(), length, type_overrides.null_mapping.time64_null, result );
   }
+  index += length;
 }
 
 template<>
@@ -498,18 +698,43 @@ void AppendArray<arrow::Type::DECIMAL>(shared_ptr<arrow::Array> array_data, K k_
   auto dec_array = static_pointer_cast<arrow::Decimal128Array>(array_data);
   auto dec_type = static_pointer_cast<arrow::Decimal128Type>(dec_array->type());
   auto length = dec_array->length();
-  for( auto i = 0; i < length; ++i ){
-    auto decimal = arrow::Decimal128(dec_array->Value(i));
-    if (type_overrides.decimal128_as_double) {
-      // Convert the decimal to a double
-      kF(k_array)[index++] =  type_overrides.null_mapping.have_decimal && dec_array->IsNull( i ) ? type_overrides.null_mapping.decimal_null : decimal.ToDouble( dec_type->scale() );
-    } else {
-      // Each decimal is a list of 16 bytes
-      K k_dec = ktn(KG, 16);
-      decimal.ToBytes(kG(k_dec));
-      kK(k_array)[index++] = k_dec;
+  auto map_nulls = type_overrides.null_mapping.have_decimal && dec_array->null_count();
+  // Each decimal128 is two little endian 64 bit words, low word first.  When
+  // the precision fits in a long the low word is the whole unscaled value.
+  auto words = reinterpret_cast<const int64_t*>( dec_array->raw_values() );
+  if( k_array->t == KJ ){
+    // Unscaled value as a long
+    auto result = ( int64_t* )&kJ( k_array )[index];
+    for( auto i = 0; i < length; ++i )
+      result[i] = words[2 * i];
+    if( map_nulls )
+      BlendNullMapping<int64_t>( dec_array->null_bitmap_data(), dec_array->offset(), length, nj, result );
+  }
+  else if( k_array->t == KF ){
+    // Convert the decimal to a double
+    auto result = ( double* )&kF( k_array )[index];
+    auto scale = dec_type->scale();
+    if( dec_type->precision() <= max_long_decimal_digits && scale >= 0 && scale <= max_long_decimal_digits ){
+      const double divisor = PowerOfTen( scale );
+      for( auto i = 0; i < length; ++i )
+        result[i] = static_cast<double>( words[2 * i] ) / divisor;
+    }
+    else{
+      for( auto i = 0; i < length; ++i )
+        result[i] = arrow::Decimal128( dec_array->Value( i ) ).ToDouble( scale );
     }
+    if( map_nulls )
+      BlendNullMapping<double>( dec_array->null_bitmap_data(), dec_array->offset(), length, type_overrides.null_mapping.decimal_null, result );
   }
+  else{
+    // Each decimal is a list of 16 bytes
+    for( auto i = 0; i < length; ++i ){
+      K k_dec = ktn( KG, 16 );
+      arrow::Decimal128( dec_array->Value( i ) ).ToBytes( kG( k_dec ) );
+      kK( k_array )[index + i] = k_dec;
+    }
+  }
+  index += length;
 }
 
 template<>
@@ -517,30 +742,21 @@ void AppendArray<arrow::Type::DURATION>(shared_ptr<arrow::Array> array_data, K k
 {
   TemporalConversion tc(array_data->type());
   auto dur_array = static_pointer_cast<arrow::DurationArray>(array_data);
-  auto duration_type = static_pointer_cast<arrow::DurationType>(dur_array->type());
   auto length = dur_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kJ( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_duration && dur_array->IsNull( i ) ) * type_overrides.null_mapping.duration_null )
-      + ( !( type_overrides.null_mapping.have_duration && dur_array->IsNull( i ) ) * tc.ArrowToKdb( dur_array->Value( i ) ) );
+  auto result = ( int64_t* )&kJ( k_array )[index];
+  tc.ArrowToKdb( dur_array->raw_values(), length, result );
+  if( type_overrides.null_mapping.have_duration && dur_array->null_count() ){
+    BlendNullMapping<int64_t>( dur_array->null_bitmap_data(), dur_array->offset(), length, type_overrides.null_mapping.duration_null, result );
   }
+  index += length;
 }
 
 template<>
 void AppendArray<arrow::Type::INTERVAL_MONTHS>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  auto month_array = static_pointer_cast<arrow::MonthIntervalArray>(array_data);
-  auto length = month_array->length();
-  if( type_overrides.null_mapping.have_month_interval && month_array->null_count() ){
-    for( auto i = 0ll; i < length; ++i ){
-      kI( k_array )[i] = ( month_array->IsNull( i ) * type_overrides.null_mapping.month_interval_null )
-        + ( !month_array->IsNull( i ) * month_array->Value( i ) );
-    }
-  }
-  else {
-    memcpy( &kI( k_array )[index], month_array->raw_values(), length * sizeof( arrow::MonthIntervalArray::value_type ) );
-  }
-  index += length;
+  AppendPrimitiveArray<arrow::MonthIntervalArray, int32_t>( array_data, ( int32_t* )&kI( k_array )[index],
+    type_overrides.null_mapping.have_month_interval, ( int32_t )type_overrides.null_mapping.month_interval_null );
+  index += array_data->length();
 }
 
 template<>
@@ -548,35 +764,36 @@ void AppendArray<arrow::Type::INTERVAL_DAY_TIME>(shared_ptr<arrow::Array> array_
 {
   auto dt_array = static_pointer_cast<arrow::DayTimeIntervalArray>(array_data);
   auto length = dt_array->length();
-  for( auto i = 0; i < length; ++i ){
-    kJ( k_array )[index++] =
-      ( ( type_overrides.null_mapping.have_day_time_interval && dt_array->IsNull( i ) ) * type_overrides.null_mapping.day_time_interval_null )
-      + ( !( type_overrides.null_mapping.have_day_time_interval && dt_array->IsNull( i ) ) * DayTimeInterval_KTimespan( dt_array->Value( i ) ) );
+  auto result = ( int64_t* )&kJ( k_array )[index];
+  DayTimeInterval_KTimespan( reinterpret_cast<const arrow::DayTimeIntervalType::c_type*>( dt_array->raw_values() ), length, result );
+  if( type_overrides.null_mapping.have_day_time_interval && dt_array->null_count() ){
+    BlendNullMapping<int64_t>( dt_array->null_bitmap_data(), dt_array->offset(), length, type_overrides.null_mapping.day_time_interval_null, result );
   }
+  index += length;
 }
 
 template<>
 void AppendArray<arrow::Type::LIST>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendList<arrow::ListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArray);
+  AppendList<arrow::ListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbType, kx::arrowkdb::AppendArray);
 }
 
 template<>
 void AppendArray<arrow::Type::LARGE_LIST>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendList<arrow::LargeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArray);
+  AppendList<arrow::LargeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbType, kx::arrowkdb::AppendArray);
 }
 
 template<>
 void AppendArray<arrow::Type::FIXED_SIZE_LIST>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendList<arrow::FixedSizeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArray);
+  AppendList<arrow::FixedSizeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbType, kx::arrowkdb::AppendArray);
 }
 
 template<>
 void AppendArray<arrow::Type::MAP>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendMap(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArray);
+  AppendMap(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbType, kx::arrowkdb::AppendArray);
 }
 
 template<>
@@ -600,7 +817,15 @@ void AppendArray<arrow::Type::DENSE_UNION>(shared_ptr<arrow::Array> array_data,
 template<>
 void AppendArray<arrow::Type::DICTIONARY>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendDictionary(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArray);
+  if (k_array->t == KS) {
+    auto value_type = static_pointer_cast<arrow::DictionaryType>(array_data->type())->value_type();
+    if (value_type->id() == arrow::Type::STRING)
+      AppendSymbolDictionary<arrow::StringArray>(array_data, k_array, index, type_overrides.null_mapping.have_string, type_overrides.null_mapping.string_null);
+    else
+      AppendSymbolDictionary<arrow::LargeStringArray>(array_data, k_array, index, type_overrides.null_mapping.have_large_string, type_overrides.null_mapping.large_string_null);
+  } else {
+    AppendDictionary(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArray);
+  }
 }
 
 using ArrayHandler = void (*) (shared_ptr<arrow::Array>, K, size_t&, TypeMappingOverride&);
@@ -659,25 +884,25 @@ void AppendArrayNullBitmap(shared_ptr<arrow::Array> array_data, K k_array, size_
 template<>
 void AppendArrayNullBitmap<arrow::Type::LIST>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendList<arrow::ListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArrayNullBitmap);
+  AppendList<arrow::ListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbTypeNullBitmap, kx::arrowkdb::AppendArrayNullBitmap);
 }
 
 template<>
 void AppendArrayNullBitmap<arrow::Type::LARGE_LIST>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendList<arrow::LargeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArrayNullBitmap);
+  AppendList<arrow::LargeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbTypeNullBitmap, kx::arrowkdb::AppendArrayNullBitmap);
 }
 
 template<>
 void AppendArrayNullBitmap<arrow::Type::FIXED_SIZE_LIST>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendList<arrow::FixedSizeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArrayNullBitmap);
+  AppendList<arrow::FixedSizeListArray>(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbTypeNullBitmap, kx::arrowkdb::AppendArrayNullBitmap);
 }
 
 template<>
 void AppendArrayNullBitmap<arrow::Type::MAP>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendMap(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArrayNullBitmap);
+  AppendMap(array_data, k_array, index, type_overrides, kx::arrowkdb::GetKdbTypeNullBitmap, kx::arrowkdb::AppendArrayNullBitmap);
 }
 
 template<>
@@ -701,7 +926,12 @@ void AppendArrayNullBitmap<arrow::Type::DENSE_UNION>(shared_ptr<arrow::Array> ar
 template<>
 void AppendArrayNullBitmap<arrow::Type::DICTIONARY>(shared_ptr<arrow::Array> array_data, K k_array, size_t& index, TypeMappingOverride& type_overrides)
 {
-  AppendDictionary(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArrayNullBitmap);
+  if (k_array->t == KB) {
+    for (auto i = 0; i < array_data->length(); ++i)
+      kG(k_array)[index++] = array_data->IsNull(i);
+  } else {
+    AppendDictionary(array_data, k_array, index, type_overrides, kx::arrowkdb::ReadArrayNullBitmap);
+  }
 }
 
 template<arrow::Type::type TypeId>
@@ -764,8 +994,12 @@ K InitKdbForArray<arrow::Type::DENSE_UNION>(shared_ptr<arrow::DataType> datatype
 template<>
 K InitKdbForArray<arrow::Type::DICTIONARY>(shared_ptr<arrow::DataType> datatype, size_t length, TypeMappingOverride& type_overrides, GetKdbTypeCommon get_kdb_type)
 {
-  // Arrow dictionary becomes a two item mixed list
+  // Arrow dictionary becomes a two item mixed list, unless it is a dictionary
+  // of strings being mapped to a symbol list
   auto dictionary_type = static_pointer_cast<arrow::DictionaryType>(datatype);
+  if (IsSymbolDictionary(datatype, type_overrides))
+    return ktn(get_kdb_type(dictionary_type->value_type(), type_overrides), length);
+
   K result = ktn(0, 2);
 
   // Do not preallocate the child lists since AppendDictionary has to join to the
@@ -852,6 +1086,9 @@ K ReadArrayNullBitmap(shared_ptr<arrow::Array> array, TypeMappingOverride& type_
 
 K ReadChunkedArray(shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappingOverride& type_overrides)
 {
+  if (IsFlatColumn(chunked_array->type(), type_overrides))
+    return ReadFlatColumn(chunked_array, type_overrides);
+
   K k_array = InitKdbForArray(chunked_array->type(), chunked_array->length(), type_overrides, GetKdbType);
   size_t index = 0;
   for (auto j = 0; j < chunked_array->num_chunks(); ++j)
@@ -868,6 +1105,73 @@ K ReadChunkedArrayNullBitmap(shared_ptr<arrow::ChunkedArray> chunked_array, Type
   return k_array;
 }
 
+namespace {
+
+// Converts a set of chunked arrays, optionally filling the simple kdb lists in
+// parallel.  Both AppendArray and AppendArrayNullBitmap only write into
+// preallocated memory when the kdb list isn't a mixed list.  Symbol lists are
+// always filled on the calling thread since interning isn't thread safe.
+//
+// If flat_columns is set, top level string and list columns are returned in
+// the STRINGS_AS_FLAT and LIST_AS_FLAT forms.
+K ReadChunkedArraysCommon(const std::vector<std::shared_ptr<arrow::ChunkedArray>>& chunked_arrays, TypeMappingOverride& type_overrides, bool multithreaded, bool flat_columns, GetKdbTypeCommon get_kdb_type, AppendArrayCommon append_array)
+{
+  struct ChunkTask
+  {
+    std::shared_ptr<arrow::Array> chunk;
+    K k_array;
+    size_t index;
+  };
+  std::vector<ChunkTask> tasks;
+
+  const auto col_num = chunked_arrays.size();
+  K data = ktn(0, col_num);
+  for (size_t i = 0; i < col_num; ++i) {
+    auto chunked_array = chunked_arrays[i];
+    if (flat_columns && IsFlatColumn(chunked_array->type(), type_overrides)) {
+      kK(data)[i] = ReadFlatColumn(chunked_array, type_overrides);
+      continue;
+    }
+
+    K k_array = InitKdbForArray(chunked_array->type(), chunked_array->length(), type_overrides, get_kdb_type);
+    kK(data)[i] = k_array;
+
+    size_t index = 0;
+    for (auto j = 0; j < chunked_array->num_chunks(); ++j) {
+      auto chunk = chunked_array->chunk(j);
+      if (multithreaded && k_array->t > 0 && k_array->t != KS) {
+        tasks.push_back({ chunk, k_array, index });
+        index += chunk->length();
+      } else {
+        append_array(chunk, k_array, index, type_overrides);
+      }
+    }
+  }
+
+  try {
+    ParallelFor(static_cast<int>(tasks.size()), [&](int i) {
+      append_array(tasks[i].chunk, tasks[i].k_array, tasks[i].index, type_overrides);
+    });
+  } catch (...) {
+    r0(data);
+    throw;
+  }
+
+  return data;
+}
+
+} // namespace
+
+K ReadChunkedArrays(const std::vector<std::shared_ptr<arrow::ChunkedArray>>& chunked_arrays, TypeMappingOverride& type_overrides, bool multithreaded)
+{
+  return ReadChunkedArraysCommon(chunked_arrays, type_overrides, multithreaded, true, GetKdbType, AppendArray);
+}
+
+K ReadChunkedArraysNullBitmap(const std::vector<std::shared_ptr<arrow::ChunkedArray>>& chunked_arrays, TypeMappingOverride& type_overrides, bool multithreaded)
+{
+  return ReadChunkedArraysCommon(chunked_arrays, type_overrides, multithreaded, false, GetKdbTypeNullBitmap, AppendArrayNullBitmap);
+}
+
 } // namespace arrowkdb
 } // namspace kx
 
@@ -59,6 +59,24 @@ K ReadChunkedArray(std::shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappi
 */
 K ReadChunkedArrayNullBitmap( std::shared_ptr<arrow::ChunkedArray> chunked_array, TypeMappingOverride& type_overrides );
 
+/**
+ * @brief Converts the columns of an arrow table to a kdb mixed list of lists.
+ *
+ * When multithreaded, all the kdb lists are created on the calling thread.
+ * Columns which map to a simple kdb list (numeric, temporal, boolean) are then
+ * filled in by converting each of their chunks as a separate task on a thread
+ * per CPU core, since that only copies into the preallocated list.  Columns
+ * whose conversion creates nested kdb objects (strings, lists, structs, etc.)
+ * are always converted on the calling thread.
+ *
+ * @param chunked_arrays  The table columns to be converted
+ * @param type_overrides  Overrides for type mappings configured by KdbOptions
+ * @param multithreaded   Whether to convert the chunks in parallel
+ * @return                A mixed list with one kdb list per column
+*/
+K ReadChunkedArrays(const std::vector<std::shared_ptr<arrow::ChunkedArray>>& chunked_arrays, TypeMappingOverride& type_overrides, bool multithreaded);
+K ReadChunkedArraysNullBitmap(const std::vector<std::shared_ptr<arrow::ChunkedArray>>& chunked_arrays, TypeMappingOverride& type_overrides, bool multithreaded);
+
 /**
  * @brief Creates a kdb list of the correct type and specified length according
  * to the arrow datatype.  For the arrow struct/union datatypes this includes
@@ -71,6 +89,13 @@ K ReadChunkedArrayNullBitmap( std::shared_ptr<arrow::ChunkedArray> chunked_array
 */
 K InitKdbForArray(std::shared_ptr<arrow::DataType> datatype, size_t length, TypeMappingOverride& type_overrides, GetKdbTypeCommon get_kdb_type);
 
+/**
+ * @brief Equivalent of GetKdbType used when reading the null bitmap.  Returns
+ * KB for datatypes whose null bitmap is a boolean list, otherwise 0 for the
+ * nested datatypes which mirror their data structure.
+*/
+KdbType GetKdbTypeNullBitmap(std::shared_ptr<arrow::DataType> datatype, TypeMappingOverride& type_overrides);
+
 } // namespace arrowkdb
 } // namespace kx
 
@@ -89,6 +114,11 @@ extern "C"
    * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
+   *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
    * 
    * @param datatype_id The arrow datatype identifier to use for the intemediate
    * arrow array
@@ -1,17 +1,24 @@
 #include <memory>
+#include <vector>
+#include <limits>
+#include <cmath>
 #include <unordered_map>
 #include <iostream>
 #include <stdexcept>
+#include <mutex>
+#include <thread>
 
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
 #include <parquet/exception.h>
 #include <arrow/pretty_print.h>
+#include <arrow/buffer.h>
 #include <arrow/util/decimal.h>
 
 #include "ArrayWriter.h"
 #include "DatatypeStore.h"
 #include "HelperFunctions.h"
+#include "BitmapKernels.h"
 #include "TypeCheck.h"
 
 using namespace std;
@@ -338,6 +345,261 @@ shared_ptr<arrow::ArrayBuilder> GetBuilder(shared_ptr<arrow::DataType> datatype)
 namespace
 {
 
+// kdb lists whose KdbBuffer was destroyed on a thread other than the one which
+// created it, waiting to be released by ReleaseKdbBuffers on the owning thread
+std::mutex pending_release_mutex;
+std::vector<std::pair<std::thread::id, K>> pending_releases;
+
+// Arrow buffer which wraps the data of a kdb list rather than copying it.  The
+// buffer holds a reference to the kdb list, released when the last arrow array
+// using the buffer is destroyed.
+//
+// kdb reference counts may only be changed on the q thread which owns the
+// list.  Arrow can drop the last reference to a buffer on one of its own
+// threads (e.g. parallel column encoding in the parquet writer), so in that
+// case the list is queued and released by ReleaseKdbBuffers on the thread
+// which created the buffer.
+class KdbBuffer : public arrow::Buffer
+{
+public:
+  KdbBuffer(K k_array, int64_t offset, int64_t size)
+    : arrow::Buffer(kG(k_array) + offset, size), k_array_(r1(k_array)), owner_(std::this_thread::get_id())
+  {}
+
+  ~KdbBuffer() override
+  {
+    if( std::this_thread::get_id() == owner_ )
+      r0(k_array_);
+    else{
+      std::lock_guard<std::mutex> lock(pending_release_mutex);
+      pending_releases.emplace_back(owner_, k_array_);
+    }
+  }
+
+private:
+  K k_array_;
+  std::thread::id owner_;
+};
+
+// Returns the element width in bytes if the kdb list can be wrapped as the
+// values buffer of an arrow array of the datatype, otherwise 0.  This requires
+// a fixed width type with the same memory layout in kdb and arrow.
+int64_t GetZeroCopyWidth(shared_ptr<arrow::DataType> datatype, K k_array, TypeMappingOverride& type_overrides)
+{
+  switch( datatype->id() ){
+  case arrow::Type::UINT8:
+  case arrow::Type::INT8:
+    return k_array->t == KG || k_array->t == KC ? 1 : 0;
+  case arrow::Type::UINT16:
+  case arrow::Type::INT16:
+    return k_array->t == KH ? 2 : 0;
+  case arrow::Type::UINT32:
+  case arrow::Type::INT32:
+    return k_array->t == KI ? 4 : 0;
+  case arrow::Type::FLOAT:
+    return k_array->t == KE ? 4 : 0;
+  case arrow::Type::UINT64:
+  case arrow::Type::INT64:
+    return k_array->t == KJ ? 8 : 0;
+  case arrow::Type::DOUBLE:
+    return k_array->t == KF ? 8 : 0;
+  default:
+    return 0;
+  }
+}
+
+// Packs the validity of each value against the null mapping into a new bitmap
+// buffer, returning the null count
+template<typename T>
+int64_t MakeNullMappingBitmap(const uint8_t* values, int64_t length, T null_value, shared_ptr<arrow::Buffer>& bitmap)
+{
+  PARQUET_ASSIGN_OR_THROW( bitmap, arrow::AllocateBuffer( ( length + 7 ) / 8 ) );
+
+  return MakeValidityBitmap( reinterpret_cast<const T*>( values ), length, NotNullMapping<T>( null_value ), bitmap->mutable_data() );
+}
+
+// Constructs an arrow array whose values buffer is the current chunk of the
+// kdb list, without copying.  If the datatype has a null mapping the validity
+// bitmap is packed directly from the kdb values.
+shared_ptr<arrow::Array> MakeZeroCopyArray(shared_ptr<arrow::DataType> datatype, K k_array, int64_t width, TypeMappingOverride& type_overrides)
+{
+  auto chunk = type_overrides.GetChunk( k_array->n );
+  int64_t offset = chunk.first;
+  int64_t length = chunk.second;
+  auto values = make_shared<KdbBuffer>( k_array, offset * width, length * width );
+
+  const auto& null_mapping = type_overrides.null_mapping;
+  shared_ptr<arrow::Buffer> bitmap;
+  int64_t null_count = 0;
+  switch( datatype->id() ){
+  case arrow::Type::UINT8:
+    if( null_mapping.have_uint8 )
+      null_count = MakeNullMappingBitmap<uint8_t>( values->data(), length, null_mapping.uint8_null, bitmap );
+    break;
+  case arrow::Type::INT8:
+    if( null_mapping.have_int8 )
+      null_count = MakeNullMappingBitmap<int8_t>( values->data(), length, null_mapping.int8_null, bitmap );
+    break;
+  case arrow::Type::UINT16:
+    if( null_mapping.have_uint16 )
+      null_count = MakeNullMappingBitmap<uint16_t>( values->data(), length, null_mapping.uint16_null, bitmap );
+    break;
+  case arrow::Type::INT16:
+    if( null_mapping.have_int16 )
+      null_count = MakeNullMappingBitmap<int16_t>( values->data(), length, null_mapping.int16_null, bitmap );
+    break;
+  case arrow::Type::UINT32:
+    if( null_mapping.have_uint32 )
+      null_count = MakeNullMappingBitmap<uint32_t>( values->data(), length, null_mapping.uint32_null, bitmap );
+    break;
+  case arrow::Type::INT32:
+    if( null_mapping.have_int32 )
+      null_count = MakeNullMappingBitmap<int32_t>( values->data(), length, null_mapping.int32_null, bitmap );
+    break;
+  case arrow::Type::UINT64:
+    if( null_mapping.have_uint64 )
+      null_count = MakeNullMappingBitmap<uint64_t>( values->data(), length, null_mapping.uint64_null, bitmap );
+    break;
+  case arrow::Type::INT64:
+    if( null_mapping.have_int64 )
+      null_count = MakeNullMappingBitmap<int64_t>( values->data(), length, null_mapping.int64_null, bitmap );
+    break;
+  case arrow::Type::FLOAT:
+    if( null_mapping.have_float32 )
+      null_count = MakeNullMappingBitmap<float>( values->data(), length, null_mapping.float32_null, bitmap );
+    break;
+  case arrow::Type::DOUBLE:
+    if( null_mapping.have_float64 )
+      null_count = MakeNullMappingBitmap<double>( values->data(), length, null_mapping.float64_null, bitmap );
+    break;
+  default:
+    break;
+  }
+
+  // Arrays without nulls don't need a bitmap
+  if( !null_count )
+    bitmap = nullptr;
+  auto array_data = arrow::ArrayData::Make( datatype, length, { bitmap, values }, null_count );
+
+  return arrow::MakeArray( array_data );
+}
+
+// Appends the dictionary indices to an integer builder of the dictionary's
+// index type, checking that the number of distinct values fits
+template<typename IndexBuilderType>
+void AppendIndices(shared_ptr<arrow::DataType> datatype, arrow::ArrayBuilder* builder, const vector<int64_t>& indices, const vector<uint8_t>& is_valid, int64_t num_values)
+{
+  using IndexType = typename IndexBuilderType::value_type;
+  if( num_values > static_cast<int64_t>( numeric_limits<IndexType>::max() ) + 1 )
+    throw TypeCheck( "Too many distinct symbols for dictionary index, datatype: '" + datatype->ToString() + "', distinct: " + to_string( num_values ) );
+
+  auto index_builder = static_cast<IndexBuilderType*>( builder );
+  vector<IndexType> values( indices.begin(), indices.end() );
+  PARQUET_THROW_NOT_OK( index_builder->AppendValues( values.data(), static_cast<int64_t>( values.size() ), is_valid.data() ) );
+}
+
+// Appends each distinct symbol to the string or large_string values builder
+template<typename StringBuilderType>
+void AppendSymbols(arrow::ArrayBuilder* builder, const vector<S>& symbols)
+{
+  auto str_builder = static_cast<StringBuilderType*>( builder );
+  for( auto symbol: symbols )
+    PARQUET_THROW_NOT_OK( str_builder->Append( symbol ) );
+}
+
+// Construct a dictionary array of strings from a kdb symbol list.
+//
+// kdb interns symbols so each distinct value has a unique pointer.  The
+// dictionary values are therefore found by hashing the symbol pointers rather
+// than the strings, in the order they first appear.  Only the distinct symbols
+// are compared to the null mapping string (if any), which becomes a null
+// index.
+shared_ptr<arrow::Array> MakeSymbolDictionary(shared_ptr<arrow::DataType> datatype, K k_array, TypeMappingOverride& type_overrides)
+{
+  auto dictionary_type = static_pointer_cast<arrow::DictionaryType>( datatype );
+  auto value_type = dictionary_type->value_type();
+  bool is_large = value_type->id() == arrow::Type::LARGE_STRING;
+  TYPE_CHECK_ARRAY( value_type->id() != arrow::Type::STRING && !is_large, datatype->ToString(), 0, k_array->t );
+
+  auto chunk = type_overrides.GetChunk( k_array->n );
+  int64_t offset = chunk.first;
+  int64_t length = chunk.second;
+  bool have_null = is_large ? type_overrides.null_mapping.have_large_string : type_overrides.null_mapping.have_string;
+  const auto& null_string = is_large ? type_overrides.null_mapping.large_string_null : type_overrides.null_mapping.string_null;
+
+  // Index of each distinct symbol, or -1 for the null mapping symbol
+  unordered_map<S, int64_t> lookup;
+  vector<S> symbols;
+  vector<int64_t> indices( length );
+  vector<uint8_t> is_valid( length, 1 );
+  for( auto i = 0ll; i < length; ++i ){
+    S symbol = kS( k_array )[i+offset];
+    auto found = lookup.find( symbol );
+    if( found == lookup.end() ){
+      int64_t index = -1;
+      if( !have_null || null_string != symbol ){
+        index = static_cast<int64_t>( symbols.size() );
+        symbols.push_back( symbol );
+      }
+      found = lookup.emplace( symbol, index ).first;
+    }
+    if( found->second < 0 ){
+      indices[i] = 0;
+      is_valid[i] = 0;
+    }
+    else{
+      indices[i] = found->second;
+    }
+  }
+
+  auto values_builder = GetBuilder( value_type );
+  if( is_large )
+    AppendSymbols<arrow::LargeStringBuilder>( values_builder.get(), symbols );
+  else
+    AppendSymbols<arrow::StringBuilder>( values_builder.get(), symbols );
+  shared_ptr<arrow::Array> values_array;
+  PARQUET_THROW_NOT_OK( values_builder->Finish( &values_array ) );
+
+  auto index_type = dictionary_type->index_type();
+  auto indices_builder = GetBuilder( index_type );
+  auto num_values = static_cast<int64_t>( symbols.size() );
+  switch( index_type->id() ){
+  case arrow::Type::INT8:
+    AppendIndices<arrow::Int8Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::UINT8:
+    AppendIndices<arrow::UInt8Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::INT16:
+    AppendIndices<arrow::Int16Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::UINT16:
+    AppendIndices<arrow::UInt16Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::INT32:
+    AppendIndices<arrow::Int32Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::UINT32:
+    AppendIndices<arrow::UInt32Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::INT64:
+    AppendIndices<arrow::Int64Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  case arrow::Type::UINT64:
+    AppendIndices<arrow::UInt64Builder>( datatype, indices_builder.get(), indices, is_valid, num_values );
+    break;
+  default:
+    TYPE_CHECK_UNSUPPORTED( datatype->ToString() );
+  }
+  shared_ptr<arrow::Array> indices_array;
+  PARQUET_THROW_NOT_OK( indices_builder->Finish( &indices_array ) );
+
+  shared_ptr<arrow::Array> result;
+  PARQUET_ASSIGN_OR_THROW( result, arrow::DictionaryArray::FromArrays( datatype, indices_array, values_array ) );
+
+  return result;
+}
+
 // Populate a list/large_list/fixed_size_list builder
 //
 // An arrow list array is a nested set of child lists.  This is represented in
@@ -438,11 +700,9 @@ void PopulateBuilder<arrow::Type::BOOL>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto bool_builder = static_cast<arrow::BooleanBuilder*>(builder);
   if( type_overrides.null_mapping.have_boolean ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.boolean_null != static_cast<bool>( kG( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( bool_builder->AppendValues( ( uint8_t* )&kG( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( uint8_t* )&kG( k_array )[offset], length, [&]( uint8_t value ){ return type_overrides.null_mapping.boolean_null != static_cast<bool>( value ); }, valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( bool_builder->AppendValues( ( uint8_t* )&kG( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( bool_builder->AppendValues( ( uint8_t* )&kG( k_array )[offset], length ) );
@@ -457,11 +717,9 @@ void PopulateBuilder<arrow::Type::UINT8>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto uint8_builder = static_cast<arrow::UInt8Builder*>(builder);
   if( type_overrides.null_mapping.have_uint8 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.uint8_null != static_cast<uint8_t>( kG( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( uint8_builder->AppendValues( ( uint8_t* )&kG( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( uint8_t* )&kG( k_array )[offset], length, NotNullMapping<uint8_t>( type_overrides.null_mapping.uint8_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( uint8_builder->AppendValues( ( uint8_t* )&kG( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( uint8_builder->AppendValues( ( uint8_t* )&kG( k_array )[offset], length ) );
@@ -476,11 +734,9 @@ void PopulateBuilder<arrow::Type::INT8>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto int8_builder = static_cast<arrow::Int8Builder*>(builder);
   if( type_overrides.null_mapping.have_int8 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.int8_null != kG( k_array )[i+offset];
-    }
-    PARQUET_THROW_NOT_OK( int8_builder->AppendValues( ( int8_t* )&kG( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( int8_t* )&kG( k_array )[offset], length, NotNullMapping<int8_t>( type_overrides.null_mapping.int8_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( int8_builder->AppendValues( ( int8_t* )&kG( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( int8_builder->AppendValues( ( int8_t* )&kG( k_array )[offset], length ) );
@@ -495,11 +751,9 @@ void PopulateBuilder<arrow::Type::UINT16>(shared_ptr<arrow::DataType> datatype,
   int64_t length = chunk.second;
   auto uint16_builder = static_cast<arrow::UInt16Builder*>(builder);
   if( type_overrides.null_mapping.have_uint16 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.uint16_null != static_cast<uint16_t>( kH( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( uint16_builder->AppendValues( ( uint16_t* )&kH( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( uint16_t* )&kH( k_array )[offset], length, NotNullMapping<uint16_t>( type_overrides.null_mapping.uint16_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( uint16_builder->AppendValues( ( uint16_t* )&kH( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( uint16_builder->AppendValues( ( uint16_t* )&kH( k_array )[offset], length ) );
@@ -514,11 +768,9 @@ void PopulateBuilder<arrow::Type::INT16>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto int16_builder = static_cast<arrow::Int16Builder*>(builder);
   if( type_overrides.null_mapping.have_int16 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.int16_null != kH( k_array )[i+offset];
-    }
-    PARQUET_THROW_NOT_OK( int16_builder->AppendValues( ( int16_t* )&kH( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( int16_t* )&kH( k_array )[offset], length, NotNullMapping<int16_t>( type_overrides.null_mapping.int16_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( int16_builder->AppendValues( ( int16_t* )&kH( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( int16_builder->AppendValues( ( int16_t* )&kH( k_array )[offset], length) );
@@ -533,11 +785,9 @@ void PopulateBuilder<arrow::Type::UINT32>(shared_ptr<arrow::DataType> datatype,
   int64_t length = chunk.second;
   auto uint32_builder = static_cast<arrow::UInt32Builder*>(builder);
   if( type_overrides.null_mapping.have_uint32 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.uint32_null != static_cast<uint32_t>( kI( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( uint32_builder->AppendValues( ( uint32_t* )&kI( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( uint32_t* )&kI( k_array )[offset], length, NotNullMapping<uint32_t>( type_overrides.null_mapping.uint32_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( uint32_builder->AppendValues( ( uint32_t* )&kI( k_array )[offset], length, valid_bytes.data() ) );
   }
   else{
     PARQUET_THROW_NOT_OK( uint32_builder->AppendValues( ( uint32_t* )&kI( k_array )[offset], length ) );
@@ -552,11 +802,9 @@ void PopulateBuilder<arrow::Type::INT32>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto int32_builder = static_cast<arrow::Int32Builder*>(builder);
   if( type_overrides.null_mapping.have_int32 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.int32_null != kI( k_array )[i+offset];
-    }
-    PARQUET_THROW_NOT_OK( int32_builder->AppendValues( ( int32_t* )&kI( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( int32_t* )&kI( k_array )[offset], length, NotNullMapping<int32_t>( type_overrides.null_mapping.int32_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( int32_builder->AppendValues( ( int32_t* )&kI( k_array )[offset], length, valid_bytes.data() ) );
   }
   else{
     PARQUET_THROW_NOT_OK( int32_builder->AppendValues( ( int32_t* )&kI( k_array )[offset], length ) );
@@ -571,11 +819,9 @@ void PopulateBuilder<arrow::Type::UINT64>(shared_ptr<arrow::DataType> datatype,
   int64_t length = chunk.second;
   auto uint64_builder = static_cast<arrow::UInt64Builder*>(builder);
   if( type_overrides.null_mapping.have_uint64 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.uint64_null != static_cast<uint64_t>( kJ( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( uint64_builder->AppendValues( ( uint64_t* )&kJ( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( uint64_t* )&kJ( k_array )[offset], length, NotNullMapping<uint64_t>( type_overrides.null_mapping.uint64_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( uint64_builder->AppendValues( ( uint64_t* )&kJ( k_array )[offset], length, valid_bytes.data() ) );
   }
   else{
     PARQUET_THROW_NOT_OK( uint64_builder->AppendValues( ( uint64_t* )&kJ( k_array )[offset], length ) );
@@ -590,11 +836,9 @@ void PopulateBuilder<arrow::Type::INT64>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto int64_builder = static_cast<arrow::Int64Builder*>(builder);
   if( type_overrides.null_mapping.have_int64 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.int64_null != kJ( k_array )[i+offset];
-    }
-    PARQUET_THROW_NOT_OK( int64_builder->AppendValues( ( int64_t* )&kJ( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( int64_t* )&kJ( k_array )[offset], length, NotNullMapping<int64_t>( type_overrides.null_mapping.int64_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( int64_builder->AppendValues( ( int64_t* )&kJ( k_array )[offset], length, valid_bytes.data() ) );
   }
   else{
     PARQUET_THROW_NOT_OK( int64_builder->AppendValues( ( int64_t* )&kJ( k_array )[offset], length ) );
@@ -609,11 +853,9 @@ void PopulateBuilder<arrow::Type::HALF_FLOAT>(shared_ptr<arrow::DataType> dataty
   int64_t length = chunk.second;
   auto hfl_builder = static_cast<arrow::HalfFloatBuilder*>(builder);
   if( type_overrides.null_mapping.have_float16 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.float16_null != static_cast<uint16_t>( kH( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( hfl_builder->AppendValues( ( uint16_t* )&kH( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( uint16_t* )&kH( k_array )[offset], length, NotNullMapping<uint16_t>( type_overrides.null_mapping.float16_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( hfl_builder->AppendValues( ( uint16_t* )&kH( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( hfl_builder->AppendValues( ( uint16_t* )&kH( k_array )[offset], length ) );
@@ -628,11 +870,9 @@ void PopulateBuilder<arrow::Type::FLOAT>(shared_ptr<arrow::DataType> datatype, K
   int64_t length = chunk.second;
   auto fl_builder = static_cast<arrow::FloatBuilder*>(builder);
   if( type_overrides.null_mapping.have_float32 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = !is_equal( type_overrides.null_mapping.float32_null, kE( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( fl_builder->AppendValues( &kE( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( &kE( k_array )[offset], length, NotNullMapping<float>( type_overrides.null_mapping.float32_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( fl_builder->AppendValues( &kE( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( fl_builder->AppendValues( &kE( k_array )[offset], length ) );
@@ -647,11 +887,9 @@ void PopulateBuilder<arrow::Type::DOUBLE>(shared_ptr<arrow::DataType> datatype,
   int64_t length = chunk.second;
   auto dbl_builder = static_cast<arrow::DoubleBuilder*>(builder);
   if( type_overrides.null_mapping.have_float64 ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = !is_equal( type_overrides.null_mapping.float64_null, kF( k_array )[i+offset] );
-    }
-    PARQUET_THROW_NOT_OK( dbl_builder->AppendValues( &kF( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( &kF( k_array )[offset], length, NotNullMapping<double>( type_overrides.null_mapping.float64_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( dbl_builder->AppendValues( &kF( k_array )[offset], length, valid_bytes.data() ) );
   }
   else {
     PARQUET_THROW_NOT_OK( dbl_builder->AppendValues( &kF( k_array )[offset], length ) );
@@ -808,23 +1046,34 @@ void PopulateBuilder<arrow::Type::FIXED_SIZE_BINARY>(shared_ptr<arrow::DataType>
   }
 }
 
+// Converts the current chunk of a kdb temporal list to arrow values in bulk,
+// deriving the null mapping validity alongside, then appends both to the
+// builder in a single call
+template<typename BuilderType, typename T>
+void PopulateTemporalBuilder(shared_ptr<arrow::DataType> datatype, const T* values, int64_t length, bool have_null, T null_value, arrow::ArrayBuilder* builder)
+{
+  TemporalConversion tc( datatype );
+  vector<T> converted( length );
+  tc.KdbToArrow( values, length, converted.data() );
+  auto temporal_builder = static_cast<BuilderType*>( builder );
+  if( have_null ){
+    vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( values, length, NotNullMapping<T>( null_value ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( temporal_builder->AppendValues( converted.data(), length, valid_bytes.data() ) );
+  }
+  else{
+    PARQUET_THROW_NOT_OK( temporal_builder->AppendValues( converted.data(), length ) );
+  }
+}
+
 template<>
 void PopulateBuilder<arrow::Type::DATE32>(shared_ptr<arrow::DataType> datatype, K k_array, arrow::ArrayBuilder* builder, TypeMappingOverride& type_overrides)
 {
   auto chunk = type_overrides.GetChunk( k_array->n );
   int64_t offset = chunk.first;
   int64_t length = chunk.second;
-  TemporalConversion tc(datatype);
-  auto d32_builder = static_cast<arrow::Date32Builder*>(builder);
-  for( auto i = 0; i < length; ++i ){
-    if( type_overrides.null_mapping.have_date32
-        && type_overrides.null_mapping.date32_null == kI( k_array )[i+offset] ){
-      PARQUET_THROW_NOT_OK( d32_builder->AppendNull() );
-    }
-    else{
-      PARQUET_THROW_NOT_OK( d32_builder->Append( tc.KdbToArrow( kI( k_array )[i+offset] ) ) );
-    }
-  }
+  PopulateTemporalBuilder<arrow::Date32Builder, int32_t>( datatype, ( int32_t* )&kI( k_array )[offset], length,
+    type_overrides.null_mapping.have_date32, type_overrides.null_mapping.date32_null, builder );
 }
 
 template<>
@@ -833,17 +1082,8 @@ void PopulateBuilder<arrow::Type::DATE64>(shared_ptr<arrow::DataType> datatype,
   auto chunk = type_overrides.GetChunk( k_array->n );
   int64_t offset = chunk.first;
   int64_t length = chunk.second;
-  TemporalConversion tc(datatype);
-  auto d64_builder = static_cast<arrow::Date64Builder*>(builder);
-  for( auto i = 0; i < length; ++i ){
-    if( type_overrides.null_mapping.have_date64
-        && type_overrides.null_mapping.date64_null == kJ( k_array )[i+offset] ){
-      PARQUET_THROW_NOT_OK( d64_builder->AppendNull() );
-    }
-    else{
-      PARQUET_THROW_NOT_OK( d64_builder->Append( tc.KdbToArrow( kJ( k_array )[i+offset] ) ) );
-    }
-  }
+  PopulateTemporalBuilder<arrow::Date64Builder, int64_t>( datatype, ( int64_t* )&kJ( k_array )[offset], length,
+    type_overrides.null_mapping.have_date64, type_overrides.null_mapping.date64_null, builder );
 }
 
 template<>
@@ -852,18 +1092,8 @@ void PopulateBuilder<arrow::Type::TIMESTAMP>(shared_ptr<arrow::DataType> datatyp
   auto chunk = type_overrides.GetChunk( k_array->n );
   int64_t offset = chunk.first;
   int64_t length = chunk.second;
-  TemporalConversion tc(datatype);
-  auto ts_builder = static_cast<arrow::TimestampBuilder*>(builder);
-  auto timestamp_type = static_pointer_cast<arrow::TimestampType>(datatype);
-  for( auto i = 0; i < length; ++i ){
-    if( type_overrides.null_mapping.have_timestamp
-        && type_overrides.null_mapping.timestamp_null == kJ( k_array )[i+offset] ){
-      PARQUET_THROW_NOT_OK( ts_builder->AppendNull() );
-    }
-    else{
-      PARQUET_THROW_NOT_OK( ts_builder->Append( tc.KdbToArrow( kJ( k_array )[i+offset] ) ) );
-    }
-  }
+  PopulateTemporalBuilder<arrow::TimestampBuilder, int64_t>( datatype, ( int64_t* )&kJ( k_array )[offset], length,
+    type_overrides.null_mapping.have_timestamp, type_overrides.null_mapping.timestamp_null, builder );
 }
 
 template<>
@@ -872,18 +1102,8 @@ void PopulateBuilder<arrow::Type::TIME32>(shared_ptr<arrow::DataType> datatype,
   auto chunk = type_overrides.GetChunk( k_array->n );
   int64_t offset = chunk.first;
   int64_t length = chunk.second;
-  TemporalConversion tc(datatype);
-  auto t32_builder = static_cast<arrow::Time32Builder*>(builder);
-  auto time32_type = static_pointer_cast<arrow::Time32Type>(datatype);
-  for( auto i = 0; i < length; ++i ){
-    if( type_overrides.null_mapping.have_time32
-        && type_overrides.null_mapping.time32_null == kI( k_array )[i+offset] ){
-      PARQUET_THROW_NOT_OK( t32_builder->AppendNull() );
-    }
-    else{
-      PARQUET_THROW_NOT_OK( t32_builder->Append( tc.KdbToArrow( kI( k_array )[i+offset] ) ) );
-    }
-  }
+  PopulateTemporalBuilder<arrow::Time32Builder, int32_t>( datatype, ( int32_t* )&kI( k_array )[offset], length,
+    type_overrides.null_mapping.have_time32, type_overrides.null_mapping.time32_null, builder );
 }
 
 template<>
@@ -892,18 +1112,63 @@ void PopulateBuilder<arrow::Type::TIME64>(shared_ptr<arrow::DataType> datatype,
   auto chunk = type_overrides.GetChunk( k_array->n );
   int64_t offset = chunk.first;
   int64_t length = chunk.second;
-  TemporalConversion tc(datatype);
-  auto t64_builder = static_cast<arrow::Time64Builder*>(builder);
-  auto time64_type = static_pointer_cast<arrow::Time64Type>(datatype);
-  for( auto i = 0; i < length; ++i ){
-    if( type_overrides.null_mapping.have_time64
-        && type_overrides.null_mapping.time64_null == kJ( k_array )[i+offset] ){
-      PARQUET_THROW_NOT_OK( t64_builder->AppendNull() );
-    }
-    else{
-      PARQUET_THROW_NOT_OK( t64_builder->Append( tc.KdbToArrow( kJ( k_array )[i+offset] ) ) );
+  PopulateTemporalBuilder<arrow::Time64Builder, int64_t>( datatype, ( int64_t* )&kJ( k_array )[offset], length,
+    type_overrides.null_mapping.have_time64, type_overrides.null_mapping.time64_null, builder );
+}
+
+// Writes each long as the two little endian 64 bit words of a decimal128, low
+// word first, sign extending into the high word.  Values whose valid_bytes
+// entry is nonzero (or all values if valid_bytes is null) must have fewer
+// digits than the type's precision, as Decimal128::FromReal requires of
+// doubles, otherwise a TypeCheck is thrown.
+void ScaledLongToDecimal(const int64_t* values, int64_t length, shared_ptr<arrow::Decimal128Type> dec_type, const uint8_t* valid_bytes, int64_t* words)
+{
+  // Only used for precisions up to max_long_decimal_digits, so the limit fits
+  // in a long
+  int64_t limit = 1;
+  for( int32_t i = 0; i < dec_type->precision(); ++i )
+    limit *= 10;
+
+  for( int64_t i = 0; i < length; ++i ){
+    if( ( values[i] >= limit || values[i] <= -limit ) && ( !valid_bytes || valid_bytes[i] ) )
+      throw TypeCheck( "Invalid value, datatype: '" + dec_type->ToString() + "', " + std::to_string( values[i] ) + " exceeds the precision" );
+    words[2 * i] = values[i];
+    words[2 * i + 1] = values[i] >> 63;
+  }
+}
+
+// Converts doubles to decimal128 words.  Where the precision fits in a long
+// each value is scaled and rounded in a single pass.  Values which are out of
+// range, not finite or too close to a rounding tie for the product to be
+// trusted are then redone with Decimal128::FromReal, which also reports any
+// errors.  Values whose valid_bytes entry is zero are skipped.
+void DoubleToDecimal(const double* values, int64_t length, int32_t precision, int32_t scale, const uint8_t* valid_bytes, int64_t* words)
+{
+  vector<uint8_t> inexact( length, 1 );
+  if( precision <= max_long_decimal_digits && scale >= 0 && scale <= max_long_decimal_digits ){
+    const double multiplier = PowerOfTen( scale );
+    const double limit = PowerOfTen( precision );
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    for( int64_t i = 0; i < length; ++i ){
+      const double scaled = values[i] * multiplier;
+      const double rounded = std::round( scaled );
+      const bool in_range = std::fabs( rounded ) < limit;
+      const int64_t unscaled = in_range ? static_cast<int64_t>( rounded ) : 0;
+      words[2 * i] = unscaled;
+      words[2 * i + 1] = unscaled >> 63;
+      const double tie_distance = std::fabs( std::fabs( scaled - std::trunc( scaled ) ) - 0.5 );
+      inexact[i] = !( in_range && tie_distance > std::fabs( scaled ) * epsilon );
     }
   }
+
+  for( int64_t i = 0; i < length; ++i ){
+    if( !inexact[i] || ( valid_bytes && !valid_bytes[i] ) )
+      continue;
+    arrow::Decimal128 dec128;
+    PARQUET_ASSIGN_OR_THROW( dec128, arrow::Decimal128::FromReal( values[i], precision, scale ) );
+    words[2 * i] = static_cast<int64_t>( dec128.low_bits() );
+    words[2 * i + 1] = dec128.high_bits();
+  }
 }
 
 template<>
@@ -914,27 +1179,46 @@ void PopulateBuilder<arrow::Type::DECIMAL>(shared_ptr<arrow::DataType> datatype,
   int64_t length = chunk.second;
   auto dec_builder = static_cast<arrow::Decimal128Builder*>(builder);
   auto dec_type = static_pointer_cast<arrow::Decimal128Type>(datatype);
-  for (auto i = 0; i < length; ++i) {
-    if (type_overrides.decimal128_as_double) {
-      if( type_overrides.null_mapping.have_decimal
-          && is_equal( type_overrides.null_mapping.decimal_null, kF( k_array )[i+offset] ) ){
-        PARQUET_THROW_NOT_OK( dec_builder->AppendNull() );
-      }
-      else{
-        // Construct the decimal from a double
-        arrow::Decimal128 dec128;
-        PARQUET_ASSIGN_OR_THROW(dec128, arrow::Decimal128::FromReal(kF(k_array)[i+offset], dec_type->precision(), dec_type->scale()));
-        PARQUET_THROW_NOT_OK(dec_builder->Append(dec128));
-      }
-    } else {
-      // Each decimal is a list of 16 bytes
-      K k_dec = kK(k_array)[i+offset];
-      TYPE_CHECK_LENGTH(k_dec->n != 16, datatype->ToString(), 16, k_dec->n);
-      TYPE_CHECK_ITEM(k_dec->t != KG, datatype->ToString(), KG, k_dec->t);
-
-      arrow::Decimal128 dec128((const uint8_t*)kG(k_dec));
-      PARQUET_THROW_NOT_OK(dec_builder->Append(dec128));
+  // The DECIMAL128_AS_SCALED_LONG and DECIMAL128_AS_DOUBLE options select the
+  // kdb type, as for reading
+  auto expected = GetKdbType( datatype, type_overrides );
+  TYPE_CHECK_ARRAY( k_array->t != expected, datatype->ToString(), expected, k_array->t );
+  if( k_array->t == KJ ){
+    // Unscaled value as a long
+    auto values = ( const int64_t* )&kJ( k_array )[offset];
+    vector<uint8_t> valid_bytes;
+    if( type_overrides.null_mapping.have_decimal ){
+      valid_bytes.resize( length );
+      MakeValidBytes( values, length, NotNullMapping<int64_t>( nj ), valid_bytes.data() );
     }
+    vector<int64_t> words( 2 * length );
+    ScaledLongToDecimal( values, length, dec_type, valid_bytes.empty() ? nullptr : valid_bytes.data(), words.data() );
+    PARQUET_THROW_NOT_OK( dec_builder->AppendValues( ( const uint8_t* )words.data(), length, valid_bytes.empty() ? nullptr : valid_bytes.data() ) );
+    return;
+  }
+
+  if( k_array->t == KF ){
+    // Construct the decimals from doubles
+    auto values = ( const double* )&kF( k_array )[offset];
+    vector<uint8_t> valid_bytes;
+    if( type_overrides.null_mapping.have_decimal ){
+      valid_bytes.resize( length );
+      MakeValidBytes( values, length, NotNullMapping<double>( type_overrides.null_mapping.decimal_null ), valid_bytes.data() );
+    }
+    vector<int64_t> words( 2 * length );
+    DoubleToDecimal( values, length, dec_type->precision(), dec_type->scale(), valid_bytes.empty() ? nullptr : valid_bytes.data(), words.data() );
+    PARQUET_THROW_NOT_OK( dec_builder->AppendValues( ( const uint8_t* )words.data(), length, valid_bytes.empty() ? nullptr : valid_bytes.data() ) );
+    return;
+  }
+
+  for (auto i = 0; i < length; ++i) {
+    // Each decimal is a list of 16 bytes
+    K k_dec = kK(k_array)[i+offset];
+    TYPE_CHECK_LENGTH(k_dec->n != 16, datatype->ToString(), 16, k_dec->n);
+    TYPE_CHECK_ITEM(k_dec->t != KG, datatype->ToString(), KG, k_dec->t);
+
+    arrow::Decimal128 dec128((const uint8_t*)kG(k_dec));
+    PARQUET_THROW_NOT_OK(dec_builder->Append(dec128));
   }
 }
 
@@ -944,18 +1228,8 @@ void PopulateBuilder<arrow::Type::DURATION>(shared_ptr<arrow::DataType> datatype
   auto chunk = type_overrides.GetChunk( k_array->n );
   int64_t offset = chunk.first;
   int64_t length = chunk.second;
-  TemporalConversion tc(datatype);
-  auto dur_builder = static_cast<arrow::DurationBuilder*>(builder);
-  auto duration_type = static_pointer_cast<arrow::DurationType>(datatype);
-  for( auto i = 0; i < length; ++i ){
-    if( type_overrides.null_mapping.have_duration
-        && type_overrides.null_mapping.duration_null == kJ( k_array )[i+offset] ){
-      PARQUET_THROW_NOT_OK( dur_builder->AppendNull() );
-    }
-    else{
-      PARQUET_THROW_NOT_OK( dur_builder->Append( tc.KdbToArrow( kJ( k_array )[i+offset] ) ) );
-    }
-  }
+  PopulateTemporalBuilder<arrow::DurationBuilder, int64_t>( datatype, ( int64_t* )&kJ( k_array )[offset], length,
+    type_overrides.null_mapping.have_duration, type_overrides.null_mapping.duration_null, builder );
 }
 
 template<>
@@ -966,11 +1240,9 @@ void PopulateBuilder<arrow::Type::INTERVAL_MONTHS>(shared_ptr<arrow::DataType> d
   int64_t length = chunk.second;
   auto month_builder = static_cast<arrow::MonthIntervalBuilder*>(builder);
   if( type_overrides.null_mapping.have_month_interval ){
-    std::vector<bool> null_bitmap( length );
-    for( auto i = 0ll; i < length; ++i ){
-      null_bitmap[i] = type_overrides.null_mapping.month_interval_null != kI( k_array )[i+offset];
-    }
-    PARQUET_THROW_NOT_OK( month_builder->AppendValues( ( int32_t* )&kI( k_array )[offset], length, null_bitmap ) );
+    std::vector<uint8_t> valid_bytes( length );
+    MakeValidBytes( ( int32_t* )&kI( k_array )[offset], length, NotNullMapping<int32_t>( type_overrides.null_mapping.month_interval_null ), valid_bytes.data() );
+    PARQUET_THROW_NOT_OK( month_builder->AppendValues( ( int32_t* )&kI( k_array )[offset], length, valid_bytes.data() ) );
   }
   else{
     PARQUET_THROW_NOT_OK( month_builder->AppendValues( ( int32_t* )&kI( k_array )[offset], length ) );
@@ -1174,6 +1446,10 @@ void PopulateBuilder(shared_ptr<arrow::DataType> datatype, K k_array, arrow::Arr
 // containing the values and indicies sub-lists.
 shared_ptr<arrow::Array> MakeDictionary(shared_ptr<arrow::DataType> datatype, K k_array, TypeMappingOverride& type_overrides)
 {
+  // A symbol list is interned into a dictionary of strings
+  if (k_array->t == KS)
+    return MakeSymbolDictionary(datatype, k_array, type_overrides);
+
   K values = kK(k_array)[0];
   K indicies = kK(k_array)[1];
 
@@ -1196,6 +1472,13 @@ shared_ptr<arrow::Array> MakeArray(shared_ptr<arrow::DataType> datatype, K k_arr
   if (datatype->id() == arrow::Type::DICTIONARY) 
     return MakeDictionary(datatype, k_array, type_overrides);
 
+  // Wrap the kdb list's memory where the layouts match
+  if (type_overrides.zero_copy) {
+    auto width = GetZeroCopyWidth(datatype, k_array, type_overrides);
+    if (width)
+      return MakeZeroCopyArray(datatype, k_array, width, type_overrides);
+  }
+
   // Construct a array builder for this datatype and populate it from the kdb
   // list
   auto builder = GetBuilder(datatype);
@@ -1215,6 +1498,20 @@ shared_ptr<arrow::ChunkedArray> MakeChunkedArray(
   type_overrides.chunk_offset = 0;
   vector<shared_ptr<arrow::Array>> chunks;
   int64_t num_chunks = type_overrides.NumChunks( k_array->n );
+  if( datatype->id() == arrow::Type::DICTIONARY && k_array->t == KS ){
+    // Intern the whole symbol list once and slice it, so that every chunk
+    // shares the same dictionary as required by the arrow IPC file format
+    auto whole_overrides = type_overrides;
+    whole_overrides.chunk_length = 0;
+    auto array = MakeSymbolDictionary( datatype, k_array, whole_overrides );
+    for( int64_t i = 0; i < num_chunks; ++i ){
+      auto chunk = type_overrides.GetChunk( k_array->n );
+      chunks.push_back( array->Slice( chunk.first, chunk.second ) );
+      type_overrides.chunk_offset += type_overrides.chunk_length;
+    }
+
+    return make_shared<arrow::ChunkedArray>( move( chunks ) );
+  }
   for( int64_t i = 0; i < num_chunks; ++i ){
     auto array = MakeArray( datatype, k_array, type_overrides );
     chunks.push_back( array );
@@ -1226,6 +1523,113 @@ shared_ptr<arrow::ChunkedArray> MakeChunkedArray(
   return chunked_array;
 }
 
+vector<shared_ptr<arrow::ChunkedArray>> MakeChunkedArrays(
+      shared_ptr<arrow::Schema> schema
+    , K array_data
+    , TypeMappingOverride& type_overrides
+    , bool multithreaded )
+{
+  if( array_data->t != 0 )
+    throw TypeCheck( "array_data not mixed list" );
+  if( array_data->n < schema->num_fields() )
+    throw TypeCheck( "array_data length less than number of schema fields" );
+  vector<shared_ptr<arrow::ChunkedArray>> chunked_arrays;
+  if( array_data->t == 0 && array_data->n == 0 ){
+    // Empty table
+  }
+  else if( multithreaded ){
+    // The zero copy fields are wrapped on the calling thread since that
+    // reference counts the kdb lists.  Only the remaining fields are worth
+    // converting in parallel.
+    chunked_arrays.resize( schema->num_fields() );
+    vector<int> copied_fields;
+    for( auto i = 0; i < schema->num_fields(); ++i ){
+      auto datatype = schema->field( i )->type();
+      if( type_overrides.zero_copy && GetZeroCopyWidth( datatype, kK( array_data )[i], type_overrides ) )
+        chunked_arrays[i] = MakeChunkedArray( datatype, kK( array_data )[i], type_overrides );
+      else
+        copied_fields.push_back( i );
+    }
+
+    // MakeChunkedArray updates the chunk offset so each field needs its own
+    // copy of the overrides.  Any exception is rethrown on the calling thread
+    // so the original error message is returned to kdb.
+    ParallelFor( static_cast<int>( copied_fields.size() ), [&]( int j ){
+      auto i = copied_fields[j];
+      auto field_overrides = type_overrides;
+      field_overrides.zero_copy = false;
+      chunked_arrays[i] = MakeChunkedArray( schema->field( i )->type(), kK( array_data )[i], field_overrides );
+    } );
+  }
+  else{
+    // Only count up to the number of schema fields.  Additional trailing data
+    // in the kdb mixed list is ignored (to allow for ::)
+    for( auto i = 0; i < schema->num_fields(); ++i ){
+      auto k_array = kK( array_data )[i];
+      chunked_arrays.push_back( MakeChunkedArray( schema->field(i)->type(), k_array, type_overrides ) );
+    }
+  }
+
+  return chunked_arrays;
+}
+
+shared_ptr<arrow::Schema> ApplySymbolsAsDictionary(
+      shared_ptr<arrow::Schema> schema
+    , K array_data
+    , TypeMappingOverride& type_overrides )
+{
+  if( !type_overrides.symbols_as_dictionary || array_data->t != 0 )
+    return schema;
+
+  auto fields = schema->fields();
+  bool changed = false;
+  for( auto i = 0; i < schema->num_fields() && i < array_data->n; ++i ){
+    auto datatype = fields[i]->type();
+    bool is_string = datatype->id() == arrow::Type::STRING || datatype->id() == arrow::Type::LARGE_STRING;
+    if( is_string && kK( array_data )[i]->t == KS ){
+      fields[i] = fields[i]->WithType( arrow::dictionary( arrow::int32(), datatype ) );
+      changed = true;
+    }
+  }
+
+  return changed ? arrow::schema( fields, schema->metadata() ) : schema;
+}
+
+void CheckSymbolsAsDictionary(
+      shared_ptr<arrow::Schema> schema
+    , K array_data
+    , int64_t row_group )
+{
+  if( array_data->t != 0 )
+    return;
+
+  for( auto i = 0; i < schema->num_fields() && i < array_data->n; ++i ){
+    auto k_array = kK( array_data )[i];
+    if( schema->field( i )->type()->id() == arrow::Type::DICTIONARY && k_array->t != KS )
+      throw TypeCheck( "SYMBOLS_AS_DICTIONARY field '" + schema->field( i )->name() + "' in row group " + to_string( row_group ) + " is not a symbol list, received: " + to_string( k_array->t ) + "h" );
+  }
+}
+
+void ReleaseKdbBuffers()
+{
+  std::vector<K> releases;
+  {
+    std::lock_guard<std::mutex> lock(pending_release_mutex);
+    auto owner = std::this_thread::get_id();
+    auto it = pending_releases.begin();
+    while( it != pending_releases.end() ){
+      if( it->first == owner ){
+        releases.push_back( it->second );
+        it = pending_releases.erase( it );
+      }
+      else
+        ++it;
+    }
+  }
+  for( auto k_array : releases )
+    r0( k_array );
+}
+
 } // namespace arrowkdb
 } // namespace kx
 
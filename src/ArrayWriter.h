@@ -21,7 +21,12 @@ namespace arrowkdb {
 void PopulateBuilder(std::shared_ptr<arrow::DataType> datatype, K k_array, arrow::ArrayBuilder* builder, TypeMappingOverride& type_overrides);
 
 /**
- * @brief Copies and converts a kdb list to an arrow array
+ * @brief Copies and converts a kdb list to an arrow array.  Fixed width
+ * integer and floating point lists are not copied, instead the arrow array
+ * references the kdb list's memory (see TypeMappingOverride::zero_copy) with
+ * any null mapping applied as a separate validity bitmap.  The kdb list must
+ * not be modified while the array exists.  If arrow frees the array on another
+ * thread the kdb list is only released by ReleaseKdbBuffers.
  *
  * @param datatype  The datatype to use when creating the arrow array
  * @param k_array   The kdb list from which to source the data
@@ -38,6 +43,50 @@ std::shared_ptr<arrow::Array> MakeArray(std::shared_ptr<arrow::DataType> datatyp
 */
 std::shared_ptr<arrow::ChunkedArray> MakeChunkedArray( std::shared_ptr<arrow::DataType> datatype, K k_array, TypeMappingOverride& type_overrides );
 
+/**
+ * @brief Copies and converts a kdb mixed list of array data to an arrow
+ * chunked array for each schema field.  Additional trailing items in the
+ * mixed list are ignored.
+ *
+ * @param schema          The schema whose fields give the arrow datatypes
+ * @param array_data      Mixed list of kdb array data, in schema field order
+ * @param multithreaded   Convert the fields in parallel, except those which
+ * are wrapped zero copy since that reference counts the kdb lists
+ * @return                The arrow chunked arrays
+*/
+std::vector<std::shared_ptr<arrow::ChunkedArray>> MakeChunkedArrays( std::shared_ptr<arrow::Schema> schema, K array_data, TypeMappingOverride& type_overrides, bool multithreaded = false );
+
+/**
+ * @brief Applies the SYMBOLS_AS_DICTIONARY option to the schema used to write
+ * a mixed list of kdb array data.  Each top level utf8 or large_utf8 field
+ * whose data is a symbol list is changed to a dictionary of int32 indices, so
+ * that the symbols are written as dictionary arrays.
+ *
+ * @param schema      The schema of the kdb array data
+ * @param array_data  Mixed list of kdb array data, in schema field order
+ * @return            The schema to write, unchanged if the option isn't set
+*/
+std::shared_ptr<arrow::Schema> ApplySymbolsAsDictionary( std::shared_ptr<arrow::Schema> schema, K array_data, TypeMappingOverride& type_overrides );
+
+/**
+ * @brief Checks that a later row group of an incremental parquet writer
+ * still has a symbol list for every field which the first row group made a
+ * dictionary, since the file's schema can't change once it is opened.
+ *
+ * @param schema      The schema chosen by the first row group
+ * @param array_data  Mixed list of kdb array data, in schema field order
+ * @param row_group   Index of the row group being written, for the error
+*/
+void CheckSymbolsAsDictionary( std::shared_ptr<arrow::Schema> schema, K array_data, int64_t row_group );
+
+/**
+ * @brief Releases the kdb lists wrapped zero copy by this thread whose arrow
+ * buffers were destroyed on another thread.  kdb reference counts can't be
+ * changed off the owning thread so those releases are deferred until this is
+ * called, which should be after any write which may use arrow's threads.
+*/
+void ReleaseKdbBuffers();
+
 } // namespace arrowkdb
 } // namespace kx
 
@@ -54,6 +103,11 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
    * @param datatype_id The arrow datatype identifier to use for the intemediate
    * arrow array
    * @param array       The kdb list to be written to the intermediate arrow
@@ -11,6 +11,8 @@
 #include "DatatypeStore.h"
 #include "FieldStore.h"
 #include "SchemaStore.h"
+#include "ParquetReader.h"
+#include "ParquetWriter.h"
 
 
 // Main is only used for profiling on windows with arrowkdb.exe
@@ -90,6 +92,8 @@ EXP K init(K unused)
   kx::arrowkdb::GetDatatypeStore();
   kx::arrowkdb::GetFieldStore();
   kx::arrowkdb::GetSchemaStore();
+  kx::arrowkdb::GetParquetReaderStore();
+  kx::arrowkdb::GetParquetWriterStore();
 
   return (K)0;
 }
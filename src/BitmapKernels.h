@@ -0,0 +1,176 @@
+#ifndef __BITMAP_KERNELS_H__
+#define __BITMAP_KERNELS_H__
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+// Kernels used to convert between arrow validity bitmaps and kdb null mapping
+// values.
+//
+// These (and the bulk temporal conversions in TemporalConversion) are plain
+// loops without data dependent branches or std::vector<bool> so that the
+// compiler can vectorise them.  No intrinsics or per instruction set builds
+// are used, which keeps the library portable to every platform libarrow
+// supports while still getting most of the benefit at the default -O2/-O3.
+
+namespace kx {
+namespace arrowkdb {
+
+// Null mapping compare for integer values
+template<typename T, typename Enable = void>
+struct NotNullMapping
+{
+  T null;
+
+  explicit NotNullMapping(T null_value) : null(null_value) {}
+
+  bool operator()(T value) const { return value != null; }
+};
+
+// Null mapping compare for floating point values, with the same tolerance as
+// is_equal.  A NaN null matches every NaN.
+template<typename T>
+struct NotNullMapping<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+  T null;
+  bool null_is_nan;
+
+  explicit NotNullMapping(T null_value) : null(null_value), null_is_nan(std::isnan(null_value)) {}
+
+  bool operator()(T value) const
+  {
+    static const T epsilon = 2 * std::numeric_limits<T>::epsilon();
+    return null_is_nan ? value == value : !(std::fabs(value - null) <= epsilon);
+  }
+};
+
+// Writes one byte (0 or 1) for the validity of each value, as used by the
+// arrow builders' AppendValues(values, length, valid_bytes)
+template<typename T, typename IsValid>
+void MakeValidBytes(const T* values, int64_t length, IsValid is_valid, uint8_t* valid_bytes)
+{
+  for (int64_t i = 0; i < length; ++i)
+    valid_bytes[i] = static_cast<uint8_t>(is_valid(values[i]));
+}
+
+// Packs the validity of each value into an arrow bitmap (least significant
+// bit first), eight values at a time.  Any unused bits of the last byte are
+// cleared.  Returns the null count.
+template<typename T, typename IsValid>
+int64_t MakeValidityBitmap(const T* values, int64_t length, IsValid is_valid, uint8_t* bitmap)
+{
+  int64_t valid_count = 0;
+  const int64_t whole_bytes = length / 8;
+  for (int64_t i = 0; i < whole_bytes; ++i) {
+    const T* block = values + i * 8;
+    uint8_t bits = 0;
+    for (int j = 0; j < 8; ++j)
+      bits |= static_cast<uint8_t>(is_valid(block[j])) << j;
+    bitmap[i] = bits;
+    valid_count += std::bitset<8>(bits).count();
+  }
+
+  const int64_t remainder = length - whole_bytes * 8;
+  if (remainder) {
+    const T* block = values + whole_bytes * 8;
+    uint8_t bits = 0;
+    for (int j = 0; j < remainder; ++j)
+      bits |= static_cast<uint8_t>(is_valid(block[j])) << j;
+    bitmap[whole_bytes] = bits;
+    valid_count += std::bitset<8>(bits).count();
+  }
+
+  return length - valid_count;
+}
+
+// Reads up to 64 bits of an arrow bitmap starting at an arbitrary bit offset,
+// least significant bit first.  Bits past length are cleared.
+inline uint64_t LoadBitmapWord(const uint8_t* bitmap, int64_t bit_offset, int64_t length)
+{
+  const uint8_t* bytes = bitmap + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  const int64_t num_bytes = (shift + length + 7) / 8;
+
+  uint64_t word = 0;
+  for (int64_t i = 0; i < num_bytes && i < 8; ++i)
+    word |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+  word >>= shift;
+  if (num_bytes > 8)
+    word |= static_cast<uint64_t>(bytes[8]) << (64 - shift);
+
+  if (length < 64)
+    word &= (uint64_t(1) << length) - 1;
+  return word;
+}
+
+// Copies values to result, substituting the null mapping value for those
+// whose validity bit is clear.  The bitmap is walked one 64 bit word at a
+// time: runs of all valid words are copied in bulk, all null words are filled
+// and only the mixed words are blended per value.  values and result may be
+// the same array, in which case the valid values are left in place.
+template<typename T>
+void CopyWithNullMapping(const uint8_t* bitmap, int64_t bit_offset, int64_t length, const T* values, T null_value, T* result)
+{
+  int64_t run_start = 0;
+  auto flush_run = [&](int64_t run_end) {
+    if (values != result && run_end > run_start)
+      std::copy(values + run_start, values + run_end, result + run_start);
+  };
+
+  for (int64_t i = 0; i < length; i += 64) {
+    const int64_t block_length = std::min<int64_t>(64, length - i);
+    const uint64_t all_valid = block_length == 64 ? ~uint64_t(0) : (uint64_t(1) << block_length) - 1;
+    const uint64_t word = LoadBitmapWord(bitmap, bit_offset + i, block_length);
+    if (word == all_valid)
+      continue;
+
+    flush_run(i);
+    run_start = i + block_length;
+    const T* block = values + i;
+    T* out = result + i;
+    if (word == 0) {
+      std::fill(out, out + block_length, null_value);
+    } else {
+      for (int64_t j = 0; j < block_length; ++j)
+        out[j] = ((word >> j) & 1) ? block[j] : null_value;
+    }
+  }
+  flush_run(length);
+}
+
+// As above, in place
+template<typename T>
+void BlendNullMapping(const uint8_t* bitmap, int64_t bit_offset, int64_t length, T null_value, T* values)
+{
+  CopyWithNullMapping<T>(bitmap, bit_offset, length, values, null_value, values);
+}
+
+// Unpacks an arrow boolean bitmap to one byte per value.  If validity is
+// non-null the values whose validity bit is clear are set to null_value.
+inline void UnpackBooleans(const uint8_t* values, int64_t values_offset, const uint8_t* validity, int64_t validity_offset, int64_t length, uint8_t null_value, uint8_t* result)
+{
+  for (int64_t i = 0; i < length; i += 64) {
+    const int64_t block_length = std::min<int64_t>(64, length - i);
+    const uint64_t bits = LoadBitmapWord(values, values_offset + i, block_length);
+    uint8_t* out = result + i;
+    if (validity) {
+      const uint64_t valid = LoadBitmapWord(validity, validity_offset + i, block_length);
+      for (int64_t j = 0; j < block_length; ++j)
+        out[j] = ((valid >> j) & 1) ? static_cast<uint8_t>((bits >> j) & 1) : null_value;
+    } else {
+      for (int64_t j = 0; j < block_length; ++j)
+        out[j] = static_cast<uint8_t>((bits >> j) & 1);
+    }
+  }
+}
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+#endif // __BITMAP_KERNELS_H__
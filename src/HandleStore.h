@@ -0,0 +1,131 @@
+#ifndef __HANDLE_STORE_H__
+#define __HANDLE_STORE_H__
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "ArrowKdb.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+/**
+ * @brief Templated singleton which maintains a mapping from long identifiers to
+ * stateful objects (open readers, writers, etc.) which must be kept alive
+ * between calls from kdb.
+ *
+ * Modelled on the GenericStore but without the equality checks and reverse
+ * lookup since each object added represents a distinct resource, even if it
+ * refers to the same file.
+*/
+template <typename T>
+class HandleStore
+{
+private:
+  static class HandleStore* instance; // singleton instance
+
+  long counter; // incremented before an object is added
+
+  // Lookup map between the identifiers and their objects
+  std::shared_timed_mutex mutex;
+  std::map<long, T> lookup;
+
+private:
+  HandleStore() : counter(0) {};
+
+public:
+  /**
+   * @brief Returns the singlton instance, constructing it not already existing
+   * @return HandleStore instance
+  */
+  static HandleStore* Instance()
+  {
+    if (instance == nullptr)
+      instance = new HandleStore<T>();
+
+    return instance;
+  }
+
+  /**
+   * @brief Adds an object to the lookup map
+   *
+   * @param value Object to add
+   * @return      Identifier for that object
+  */
+  long Add(T value)
+  {
+    // Get write lock
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+
+    long value_id = ++counter;
+    lookup[value_id] = value;
+
+    return value_id;
+  }
+
+  /**
+   * @brief Removes an object from the lookup map
+   *
+   * @param value_id  The identifier of the object to be removed
+   * @return          The removed object if found, NULL otherwise
+  */
+  T Remove(long value_id)
+  {
+    // Get write lock
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+
+    auto it = lookup.find(value_id);
+    if (it == lookup.end())
+      return T();
+
+    auto value = it->second;
+    lookup.erase(it);
+
+    return value;
+  }
+
+  /**
+   * @brief Returns the object found by searching the lookup map for the
+   * specified identifier
+   *
+   * @param value_id The identifier of the object to search for
+   * @return         If found the object, NULL otherwise
+  */
+  T Find(long value_id)
+  {
+    // Get read lock
+    std::shared_lock<std::shared_timed_mutex> lock(mutex);
+
+    auto it = lookup.find(value_id);
+    if (it == lookup.end())
+      return T();
+
+    return it->second;
+  }
+
+  /**
+   * @brief Returns all object identifiers currently held in the store
+   *
+   * @return Vector of object identifiers
+  */
+  const std::vector<long> List(void)
+  {
+    // Get read lock
+    std::shared_lock<std::shared_timed_mutex> lock(mutex);
+
+    std::vector<long> result;
+    for (auto it : lookup)
+      result.push_back(it.first);
+    return result;
+  }
+};
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+#endif // __HANDLE_STORE_H__
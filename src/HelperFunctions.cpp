@@ -1,4 +1,15 @@
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include <arrow/util/compression.h>
+#include <parquet/exception.h>
 
 #include "HelperFunctions.h"
 #include "TypeCheck.h"
@@ -128,6 +139,27 @@ int64_t DayTimeInterval_KTimespan(arrow::DayTimeIntervalType::c_type dt_interval
   return dt_interval.days * day_as_ns + dt_interval.milliseconds * ns_ms_scale;
 }
 
+void DayTimeInterval_KTimespan(const arrow::DayTimeIntervalType::c_type* dt_intervals, int64_t length, int64_t* k_timespans)
+{
+  for (int64_t i = 0; i < length; ++i)
+    k_timespans[i] = dt_intervals[i].days * day_as_ns + dt_intervals[i].milliseconds * ns_ms_scale;
+}
+
+double PowerOfTen(int32_t exponent)
+{
+  static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+  };
+  return powers_of_ten[exponent];
+}
+
+bool IsDecimalAsScaledLong(std::shared_ptr<arrow::DataType> datatype, const TypeMappingOverride& type_overrides)
+{
+  return type_overrides.decimal128_as_scaled_long
+    && std::static_pointer_cast<arrow::Decimal128Type>(datatype)->precision() <= max_long_decimal_digits;
+}
+
 arrow::DayTimeIntervalType::c_type KTimespan_DayTimeInterval(int64_t k_timespan)
 {
   int32_t days = (int32_t)(k_timespan / day_as_ns);
@@ -145,9 +177,64 @@ const std::string GetKdbString(K str)
   return str->t == -KS ? str->s : std::string((S)kG(str), str->n);
 }
 
+std::vector<int> GetFieldIndices(std::shared_ptr<arrow::Schema> schema, const std::vector<std::string>& names)
+{
+  std::vector<int> result;
+  for (const auto& name : names) {
+    auto index = schema->GetFieldIndex(name);
+    if (index < 0)
+      throw KdbOptions::InvalidOption("COLUMNS field '" + name + "' not found");
+    if (std::find(result.begin(), result.end(), index) != result.end())
+      throw KdbOptions::InvalidOption("COLUMNS field '" + name + "' repeated");
+    result.push_back(index);
+  }
+
+  return result;
+}
+
+std::vector<std::shared_ptr<arrow::ChunkedArray>> SelectColumns(std::shared_ptr<arrow::Table> table, const std::vector<std::string>& names)
+{
+  if (names.empty())
+    return table->columns();
+
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> result;
+  for (auto index : GetFieldIndices(table->schema(), names))
+    result.push_back(table->column(index));
+
+  return result;
+}
+
+arrow::Compression::type GetCompressionType(const KdbOptions& options)
+{
+  // Convert the COMPRESSION option to an arrow compression type
+  std::string compression = "UNCOMPRESSED";
+  options.GetStringOption(Options::COMPRESSION, compression);
+
+  return GetCompressionType(compression);
+}
+
+arrow::Compression::type GetCompressionType(std::string compression)
+{
+  std::transform(compression.begin(), compression.end(), compression.begin(),
+    [](unsigned char c) { return std::tolower(c); }
+  );
+
+  arrow::Compression::type compression_type;
+  PARQUET_ASSIGN_OR_THROW(compression_type, arrow::util::Codec::GetCompressionType(compression));
+  if (!arrow::util::Codec::IsAvailable(compression_type))
+    throw KdbOptions::InvalidOption("Compression type " + compression + " not available");
+
+  return compression_type;
+}
+
 TypeMappingOverride::TypeMappingOverride(const KdbOptions& options)
 {
   options.GetIntOption(Options::DECIMAL128_AS_DOUBLE, decimal128_as_double);
+  options.GetIntOption(Options::DECIMAL128_AS_SCALED_LONG, decimal128_as_scaled_long);
+  options.GetIntOption(Options::STRINGS_AS_SYMBOLS, strings_as_symbols);
+  options.GetIntOption(Options::SYMBOLS_AS_DICTIONARY, symbols_as_dictionary);
+  options.GetIntOption(Options::STRINGS_AS_FLAT, strings_as_flat);
+  options.GetIntOption(Options::LIST_AS_FLAT, list_as_flat);
   options.GetNullMappingOptions( null_mapping );
 }
 
@@ -178,7 +265,10 @@ KdbType GetKdbType(std::shared_ptr<arrow::DataType> datatype, TypeMappingOverrid
     return KF;
   case arrow::Type::STRING:
   case arrow::Type::LARGE_STRING:
-    return 0; // mixed list of KC lists
+    if (type_overrides.strings_as_symbols)
+      return KS; // map strings to symbols
+    else
+      return 0; // mixed list of KC lists
   case arrow::Type::BINARY:
   case arrow::Type::LARGE_BINARY:
   case arrow::Type::FIXED_SIZE_BINARY:
@@ -194,7 +284,9 @@ KdbType GetKdbType(std::shared_ptr<arrow::DataType> datatype, TypeMappingOverrid
   case arrow::Type::TIME64:
     return KN;
   case arrow::Type::DECIMAL:
-    if (type_overrides.decimal128_as_double)
+    if (IsDecimalAsScaledLong(datatype, type_overrides))
+      return KJ; // map decimal128 to its unscaled value
+    else if (type_overrides.decimal128_as_double)
       return KF; // map decimal128 to double
     else
       return 0; // mixed list of KG lists of length 16
@@ -300,5 +392,123 @@ std::shared_ptr<arrow::DataType> GetArrowType(K k_array)
   return std::shared_ptr<arrow::DataType>();
 }
 
+namespace {
+
+// Process wide pool of worker threads used by ParallelFor, so that each call
+// doesn't have to create and join its own threads.  The threads wait for jobs
+// until the process exits.
+class WorkerPool
+{
+private:
+  std::mutex mutex;
+  std::condition_variable job_ready;
+  std::deque<std::function<void()>> jobs;
+  int num_threads = 0;
+
+  void Run()
+  {
+    for (;;) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        job_ready.wait(lock, [this]() { return !jobs.empty(); });
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+      job();
+    }
+  }
+
+public:
+  // If a thread can't be created the pool is left with fewer threads
+  WorkerPool(int threads)
+  {
+    try {
+      for (; num_threads < threads; ++num_threads)
+        std::thread(&WorkerPool::Run, this).detach();
+    } catch (const std::system_error&) {
+    }
+  }
+
+  int Size() const { return num_threads; }
+
+  void Submit(std::function<void()> job)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      jobs.push_back(std::move(job));
+    }
+    job_ready.notify_one();
+  }
+};
+
+// The calling thread also runs tasks, so one fewer thread than cores.  Never
+// deleted, since the detached threads use it until the process exits.
+WorkerPool& GetWorkerPool()
+{
+  static WorkerPool* pool = new WorkerPool(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1);
+  return *pool;
+}
+
+// State shared by the calling thread and the pool threads helping with one
+// ParallelFor.  Once the calling thread has finished its share it closes the
+// state, so that a helper which only starts after that (for example because
+// the pool threads were busy with the tasks of an enclosing ParallelFor) does
+// nothing rather than being waited for.
+struct ParallelForState
+{
+  std::atomic<int> next{ 0 };
+  std::mutex mutex;
+  std::condition_variable done;
+  int running = 0;
+  bool closed = false;
+  std::exception_ptr error;
+};
+
+} // namespace
+
+void ParallelFor(int num_tasks, const std::function<void(int)>& func)
+{
+  if (num_tasks <= 0)
+    return;
+
+  auto state = std::make_shared<ParallelForState>();
+  auto worker = [state, num_tasks, &func]() {
+    try {
+      for (auto i = state->next++; i < num_tasks; i = state->next++)
+        func(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!state->error)
+        state->error = std::current_exception();
+      state->next = num_tasks;
+    }
+  };
+
+  auto& pool = GetWorkerPool();
+  const int num_helpers = std::min(num_tasks - 1, pool.Size());
+  for (auto i = 0; i < num_helpers; ++i) {
+    pool.Submit([state, worker]() {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed)
+          return;
+        ++state->running;
+      }
+      worker();
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (--state->running == 0)
+        state->done.notify_all();
+    });
+  }
+  worker();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->closed = true;
+  state->done.wait(lock, [&state]() { return state->running == 0; });
+  if (state->error)
+    std::rethrow_exception(state->error);
+}
+
 } // namespace arrowkdb
 } // namespace kx
@@ -4,6 +4,9 @@
 #include <limits>
 #include <cmath>
 #include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
 
 #include <arrow/api.h>
 #include <arrow/io/api.h>
@@ -50,6 +53,22 @@ public:
     return value * (T)scalar - (T)offset;
   }
 
+  // Converts a list of arrow temporals to kdb values.  The unscaled case is a
+  // separate loop of subtractions.
+  template <typename T>
+  inline void ArrowToKdb(const T* values, int64_t length, T* result)
+  {
+    const T t_offset = (T)offset;
+    const T t_scalar = (T)scalar;
+    if (t_scalar == 1) {
+      for (int64_t i = 0; i < length; ++i)
+        result[i] = values[i] - t_offset;
+    } else {
+      for (int64_t i = 0; i < length; ++i)
+        result[i] = values[i] * t_scalar - t_offset;
+    }
+  }
+
   // Converts from a kdb temporal (either int32 or int64) to its arrow value,
   // applying the epoch offseting and scaling factor
   template <typename T>
@@ -57,14 +76,44 @@ public:
   {
     return (value + (T)offset) / (T)scalar;
   }
+
+  // Converts a list of kdb temporals to arrow values.  The unscaled case
+  // (e.g. timestamp(ns)) is a separate loop of additions since it avoids the
+  // 64 bit integer division.
+  template <typename T>
+  inline void KdbToArrow(const T* values, int64_t length, T* result)
+  {
+    const T t_offset = (T)offset;
+    const T t_scalar = (T)scalar;
+    if (t_scalar == 1) {
+      for (int64_t i = 0; i < length; ++i)
+        result[i] = values[i] + t_offset;
+    } else {
+      for (int64_t i = 0; i < length; ++i)
+        result[i] = (values[i] + t_offset) / t_scalar;
+    }
+  }
 };
 
 // Arrow day_time_interval <-> kdb timespan (KN)
 // Requires: splitting day/time and scaling
 int64_t DayTimeInterval_KTimespan(arrow::DayTimeIntervalType::c_type dt_interval);
+void DayTimeInterval_KTimespan(const arrow::DayTimeIntervalType::c_type* dt_intervals, int64_t length, int64_t* k_timespans);
 arrow::DayTimeIntervalType::c_type KTimespan_DayTimeInterval(int64_t k_timespan);
 
 
+//////////////
+// DECIMALS //
+//////////////
+
+// Decimal128 precisions up to this have unscaled values which fit in a kdb
+// long, and scales up to this have a power of ten which is exact as a double
+const int32_t max_long_decimal_digits = 18;
+
+// Returns 10^exponent for 0 <= exponent <= max_long_decimal_digits
+double PowerOfTen(int32_t exponent);
+
+
 /////////////////
 // KDB STRINGS //
 /////////////////
@@ -90,6 +139,51 @@ inline bool is_equal( T lhs, T rhs )
 }
 
 
+///////////////////////
+// COLUMN PROJECTION //
+///////////////////////
+
+/**
+ * @brief Resolves the field names selected by the COLUMNS option to the
+ * indices of the top level fields in a schema, in the requested order.
+ * Throws if a name isn't found or is repeated.
+ *
+ * @param schema  Arrow schema of the file being read
+ * @param names   Field names
+ * @return        Field indices
+*/
+std::vector<int> GetFieldIndices(std::shared_ptr<arrow::Schema> schema, const std::vector<std::string>& names);
+
+/**
+ * @brief Returns the columns of a table.  If names is not empty only those
+ * columns are returned, in the order given.
+ *
+ * @param table Arrow table
+ * @param names Field names selected by the COLUMNS option, or empty for all
+ * @return      Table columns
+*/
+std::vector<std::shared_ptr<arrow::ChunkedArray>> SelectColumns(std::shared_ptr<arrow::Table> table, const std::vector<std::string>& names);
+
+
+/////////////////
+// COMPRESSION //
+/////////////////
+
+/**
+ * @brief Converts the COMPRESSION option to an arrow compression type.
+ * Throws if the libarrow build doesn't support it.
+ *
+ * @param options Parsed kdb options
+ * @return        Compression type, default uncompressed
+*/
+arrow::Compression::type GetCompressionType(const KdbOptions& options);
+
+/**
+ * @brief As above but converting a compression name (case insensitive)
+*/
+arrow::Compression::type GetCompressionType(std::string compression);
+
+
 //////////////////
 // TYPE MAPPING //
 //////////////////
@@ -99,9 +193,17 @@ typedef signed char KdbType;
  struct TypeMappingOverride
 {
   int64_t decimal128_as_double = 0;
+  int64_t decimal128_as_scaled_long = 0;
+  int64_t strings_as_symbols = 0;
+  int64_t symbols_as_dictionary = 0;
+  int64_t strings_as_flat = 0;
+  int64_t list_as_flat = 0;
   Options::NullMapping null_mapping;
   int64_t chunk_offset = 0;
   int64_t chunk_length = 0;
+  // Wrap the memory of fixed width kdb lists in arrow arrays rather than
+  // copying.  Must be cleared when converting off the main kdb thread.
+  bool zero_copy = true;
 
   TypeMappingOverride(void) {};
   TypeMappingOverride(const KdbOptions& options);
@@ -171,6 +273,36 @@ KdbType GetKdbType(std::shared_ptr<arrow::DataType> datatype, TypeMappingOverrid
 */
 std::shared_ptr<arrow::DataType> GetArrowType(K k_array);
 
+/**
+ * @brief Whether a decimal128 datatype is mapped to a kdb long list of its
+ * unscaled values (DECIMAL128_AS_SCALED_LONG).  Only possible when the
+ * precision is at most max_long_decimal_digits.
+ *
+ * @param datatype  Arrow decimal128 datatype
+ * @return          True if mapped to KJ
+*/
+bool IsDecimalAsScaledLong(std::shared_ptr<arrow::DataType> datatype, const TypeMappingOverride& type_overrides);
+
+
+////////////////////////
+// PARALLEL EXECUTION //
+////////////////////////
+
+/**
+ * @brief Runs func(0) .. func(num_tasks-1) on up to one thread per CPU core,
+ * including the calling thread, and waits for them all to complete.  The
+ * other threads come from a process wide pool which is created on first use
+ * and reused by later calls.  If any task throws, no further tasks are
+ * started and the first exception is rethrown on the calling thread.
+ *
+ * The tasks must not touch kdb reference counts or intern symbols, since
+ * neither is thread safe.
+ *
+ * @param num_tasks Number of tasks
+ * @param func      Task function, passed the task index
+*/
+void ParallelFor(int num_tasks, const std::function<void(int)>& func);
+
 
 ///////////////////////
 // FUNCTION HANDLERS //
@@ -49,11 +49,13 @@ KdbOptions::KdbOptions(
         K options
       , const std::set<std::string>& supported_string_options_
       , const std::set<std::string>& supported_int_options_
-      , const std::set<std::string>& supported_dict_options_ )
+      , const std::set<std::string>& supported_dict_options_
+      , const std::set<std::string>& supported_list_options_ )
   : null_mapping_options {0}
   , supported_string_options(supported_string_options_)
   , supported_int_options(supported_int_options_)
   , supported_dict_options( supported_dict_options_ )
+  , supported_list_options( supported_list_options_ )
   , null_mapping_types {
       { arrow::Type::BOOL, arrowkdb::Options::NM_BOOLEAN }
     , { arrow::Type::UINT8, arrowkdb::Options::NM_UINT_8 }
@@ -144,6 +146,11 @@ void KdbOptions::PopulateStringOptions(K keys, K values)
 {
   for (auto i = 0ll; i < values->n; ++i) {
     const std::string key = ToUpper(kS(keys)[i]);
+    if (supported_list_options.find(key) != supported_list_options.end()) {
+      // Single symbol list option, symbols are case sensitive names
+      symbol_list_options[key] = { kS(values)[i] };
+      continue;
+    }
     if (supported_string_options.find(key) == supported_string_options.end())
       throw InvalidOption(("Unsupported string option '" + key + "'").c_str());
     string_options[key] = ToUpper(kS(values)[i]);
@@ -180,6 +187,89 @@ void KdbOptions::PopulateNullMappingOptions( long long index, K dict )
   }
 }
 
+void KdbOptions::PopulateParquetColumnSetting( const std::string& column, const std::string& setting, K values, long long index )
+{
+  // Each setting is a symbol or long, held in either a typed or a mixed list
+  K atom = 0 == values->t ? kK( values )[index] : nullptr;
+  const auto type = atom ? atom->t : static_cast<signed char>( -values->t );
+  if( 101 == type ){
+    // Ignore generic null, which may be used here to ensure mixed list of settings
+    return;
+  }
+
+  auto& result = parquet_column_options[column];
+  if( Options::PC_COMPRESSION == setting || Options::PC_ENCODING == setting ){
+    if( -KS != type ){
+      throw InvalidOption( "PARQUET_COLUMN_OPTIONS " + setting + " for field '" + column + "' not -11h, type=" + std::to_string( type ) + "h" );
+    }
+    const std::string value = ToUpper( atom ? atom->s : kS( values )[index] );
+    if( Options::PC_COMPRESSION == setting ){
+      result.compression = value;
+    }
+    else{
+      result.encoding = value;
+    }
+  }
+  else if( Options::PC_COMPRESSION_LEVEL == setting || Options::PC_DICTIONARY == setting ){
+    int64_t value = 0;
+    if( -KJ == type ){
+      value = atom ? atom->j : kJ( values )[index];
+    }
+    else if( -KB == type ){
+      value = atom ? atom->g : kG( values )[index];
+    }
+    else{
+      throw InvalidOption( "PARQUET_COLUMN_OPTIONS " + setting + " for field '" + column + "' not -7h, type=" + std::to_string( type ) + "h" );
+    }
+    if( Options::PC_COMPRESSION_LEVEL == setting ){
+      result.have_compression_level = true;
+      result.compression_level = value;
+    }
+    else{
+      result.have_dictionary = true;
+      result.dictionary = value != 0;
+    }
+  }
+  else{
+    throw InvalidOption( "Unsupported PARQUET_COLUMN_OPTIONS setting '" + setting + "'" );
+  }
+}
+
+void KdbOptions::PopulateParquetColumnOptions( K dict )
+{
+  K columns = kK( dict )[0];
+  K settings = kK( dict )[1];
+  if( KS != columns->t ){
+    throw InvalidOption( "Unsupported KDB data type for PARQUET_COLUMN_OPTIONS keys (expected=11h), type=" + std::to_string( columns->t ) + "h" );
+  }
+  if( XT == settings->t ){
+    // kdb collapses a list of settings dictionaries with the same keys into a
+    // table, with one row per field
+    K setting_keys = kK( settings->k )[0];
+    K setting_values = kK( settings->k )[1];
+    for( auto i = 0ll; i < columns->n; ++i ){
+      for( auto j = 0ll; j < setting_keys->n; ++j ){
+        PopulateParquetColumnSetting( kS( columns )[i], ToUpper( kS( setting_keys )[j] ), kK( setting_values )[j], i );
+      }
+    }
+  }
+  else if( 0 == settings->t ){
+    for( auto i = 0ll; i < columns->n; ++i ){
+      K item = kK( settings )[i];
+      if( XD != item->t || KS != kK( item )[0]->t ){
+        throw InvalidOption( "PARQUET_COLUMN_OPTIONS for field '" + std::string( kS( columns )[i] ) + "' not a dictionary with 11h keys" );
+      }
+      K setting_keys = kK( item )[0];
+      for( auto j = 0ll; j < setting_keys->n; ++j ){
+        PopulateParquetColumnSetting( kS( columns )[i], ToUpper( kS( setting_keys )[j] ), kK( item )[1], j );
+      }
+    }
+  }
+  else{
+    throw InvalidOption( "Unsupported KDB data type for PARQUET_COLUMN_OPTIONS values (expected=0|98h), type=" + std::to_string( settings->t ) + "h" );
+  }
+}
+
 void KdbOptions::PopulateDictOptions( K keys, K values )
 {
   for( auto i = 0ll; i < values->n; ++i ) {
@@ -191,6 +281,155 @@ void KdbOptions::PopulateDictOptions( K keys, K values )
     {
         PopulateNullMappingOptions( i, values );
     }
+    else if( Options::PARQUET_COLUMN_OPTIONS == key )
+    {
+        PopulateParquetColumnOptions( kK( values )[i] );
+    }
+  }
+}
+
+Options::FilterValue KdbOptions::MakeFilterValue( K value, long long index )
+{
+  // A negative index indicates that value is an atom rather than a list
+  const bool atom = index < 0;
+  const auto type = static_cast<signed char>( value->t < 0 ? -value->t : value->t );
+
+  Options::FilterValue result{ Options::FilterValue::INTEGER, static_cast<signed char>( -type ), 0, 0, "" };
+  switch( type ){
+  case KB:
+  case KG:
+    result.integer = atom ? value->g : kG( value )[index];
+    break;
+  case KH:
+    result.integer = atom ? value->h : kH( value )[index];
+    break;
+  case KI:
+  case KM:
+  case KD:
+  case KT:
+    result.integer = atom ? value->i : kI( value )[index];
+    break;
+  case KJ:
+  case KP:
+  case KN:
+    result.integer = atom ? value->j : kJ( value )[index];
+    break;
+  case KE:
+    result.kind = Options::FilterValue::REAL;
+    result.real = atom ? value->e : kE( value )[index];
+    break;
+  case KF:
+    result.kind = Options::FilterValue::REAL;
+    result.real = atom ? value->f : kF( value )[index];
+    break;
+  case KC:
+    result.kind = Options::FilterValue::STRING;
+    result.string = std::string( 1, atom ? static_cast<char>( value->g ) : static_cast<char>( kC( value )[index] ) );
+    break;
+  case KS:
+    result.kind = Options::FilterValue::STRING;
+    result.string = atom ? value->s : kS( value )[index];
+    break;
+  default:
+    throw InvalidOption( "Unsupported KDB data type for FILTER value, type=" + std::to_string( value->t ) + "h" );
+  }
+
+  return result;
+}
+
+void KdbOptions::PopulateFilterValues( Options::FilterPredicate& predicate, K value )
+{
+  if( KC == value->t ){
+    // A char list is a single string value
+    predicate.values.push_back( { Options::FilterValue::STRING, KC, 0, 0, std::string( ( char* )kC( value ), value->n ) } );
+  }
+  else if( value->t < 0 ){
+    predicate.values.push_back( MakeFilterValue( value, -1 ) );
+  }
+  else if( 0 == value->t ){
+    for( auto i = 0ll; i < value->n; ++i ){
+      K item = kK( value )[i];
+      if( KC == item->t ){
+        predicate.values.push_back( { Options::FilterValue::STRING, KC, 0, 0, std::string( ( char* )kC( item ), item->n ) } );
+      }
+      else if( item->t < 0 ){
+        predicate.values.push_back( MakeFilterValue( item, -1 ) );
+      }
+      else{
+        throw InvalidOption( "Unsupported KDB data type for FILTER value on column '" + predicate.column + "', type=" + std::to_string( item->t ) + "h" );
+      }
+    }
+  }
+  else{
+    for( auto i = 0ll; i < value->n; ++i ){
+      predicate.values.push_back( MakeFilterValue( value, i ) );
+    }
+  }
+
+  size_t expected = 1;
+  switch( predicate.op ){
+  case Options::FilterOperator::WITHIN:
+    expected = 2;
+    break;
+  case Options::FilterOperator::IN:
+    return;
+  default:
+    break;
+  }
+  if( predicate.values.size() != expected ){
+    throw InvalidOption( "FILTER on column '" + predicate.column + "' expects " + std::to_string( expected ) + " value(s), got " + std::to_string( predicate.values.size() ) );
+  }
+}
+
+void KdbOptions::PopulateFilterPredicate( K predicate )
+{
+  if( 0 != predicate->t || 3 != predicate->n ){
+    throw InvalidOption( "FILTER predicate must be a mixed list of (operator;column;value)" );
+  }
+  K op = kK( predicate )[0];
+  K column = kK( predicate )[1];
+  if( -KS != op->t ){
+    throw InvalidOption( "FILTER operator not -11h, type=" + std::to_string( op->t ) + "h" );
+  }
+  if( -KS != column->t ){
+    throw InvalidOption( "FILTER column not -11h, type=" + std::to_string( column->t ) + "h" );
+  }
+
+  static const std::map<std::string, Options::FilterOperator> operators = {
+      { "=", Options::FilterOperator::EQUAL }
+    , { "eq", Options::FilterOperator::EQUAL }
+    , { "<", Options::FilterOperator::LESS }
+    , { "lt", Options::FilterOperator::LESS }
+    , { "<=", Options::FilterOperator::LESS_EQUAL }
+    , { "le", Options::FilterOperator::LESS_EQUAL }
+    , { ">", Options::FilterOperator::GREATER }
+    , { "gt", Options::FilterOperator::GREATER }
+    , { ">=", Options::FilterOperator::GREATER_EQUAL }
+    , { "ge", Options::FilterOperator::GREATER_EQUAL }
+    , { "within", Options::FilterOperator::WITHIN }
+    , { "in", Options::FilterOperator::IN } };
+
+  const std::string op_name = ToLower( op->s );
+  auto it = operators.find( op_name );
+  if( it == operators.end() ){
+    throw InvalidOption( "Unsupported FILTER operator '" + op_name + "'" );
+  }
+
+  Options::FilterPredicate result{ column->s, it->second, {} };
+  PopulateFilterValues( result, kK( predicate )[2] );
+  filter_predicates.push_back( result );
+}
+
+void KdbOptions::PopulateFilterOptions( K filter )
+{
+  // Either a single (operator;column;value) predicate or a list of them
+  if( 3 == filter->n && -KS == kK( filter )[0]->t ){
+    PopulateFilterPredicate( filter );
+  }
+  else{
+    for( auto i = 0ll; i < filter->n; ++i ){
+      PopulateFilterPredicate( kK( filter )[i] );
+    }
   }
 }
 
@@ -206,10 +445,25 @@ void KdbOptions::PopulateMixedOptions(K keys, K values)
       int_options[key] = value->j;
       break;
     case -KS:
+      if (supported_list_options.find(key) != supported_list_options.end()) {
+        // Single symbol list option, symbols are case sensitive names
+        symbol_list_options[key] = { value->s };
+        break;
+      }
       if (supported_string_options.find(key) == supported_string_options.end())
         throw InvalidOption(("Unsupported string option '" + key + "'").c_str());
       string_options[key] = ToUpper(value->s);
       break;
+    case KS:
+    {
+      if (supported_list_options.find(key) == supported_list_options.end())
+        throw InvalidOption(("Unsupported list option '" + key + "'").c_str());
+      std::vector<std::string> symbols;
+      for (auto j = 0ll; j < value->n; ++j)
+        symbols.push_back(kS(value)[j]);
+      symbol_list_options[key] = symbols;
+      break;
+    }
     case KC:
     {
       if (supported_string_options.find(key) == supported_string_options.end())
@@ -226,13 +480,28 @@ void KdbOptions::PopulateMixedOptions(K keys, K values)
       {
           PopulateNullMappingOptions( i, values );
       }
+      else if( Options::PARQUET_COLUMN_OPTIONS == key )
+      {
+          PopulateParquetColumnOptions( value );
+      }
+      break;
+    }
+    case 0:
+    {
+      if( supported_list_options.find( key ) == supported_list_options.end() ){
+        throw InvalidOption(("Unsupported list option '" + key + "'").c_str());
+      }
+      if( Options::FILTER == key )
+      {
+          PopulateFilterOptions( value );
+      }
       break;
     }
     case 101:
       // Ignore ::
       break;
     default:
-      throw InvalidOption(("option '" + key + "' value not -7|-11|10h").c_str());
+      throw InvalidOption(("option '" + key + "' value not -7|-11|10|11|99|0h").c_str());
     }
   }
 }
@@ -271,6 +540,17 @@ bool KdbOptions::GetIntOption(const std::string key, int64_t& result) const
   }
 }
 
+bool KdbOptions::GetSymbolListOption(const std::string key, std::vector<std::string>& result) const
+{
+  const auto it = symbol_list_options.find(key);
+  if (it == symbol_list_options.end())
+    return false;
+  else {
+    result = it->second;
+    return true;
+  }
+}
+
 } // namespace arrowkdb
 
 } // kx
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <cctype>
 #include <set>
+#include <vector>
 #include <algorithm>
 
 #include "k.h"
@@ -26,6 +27,26 @@ namespace Options
   const std::string USE_MMAP = "USE_MMAP";
   const std::string DECIMAL128_AS_DOUBLE = "DECIMAL128_AS_DOUBLE";
   const std::string WITH_NULL_BITMAP = "WITH_NULL_BITMAP";
+  const std::string MULTITHREADED_CONVERSION = "MULTITHREADED_CONVERSION";
+  const std::string PARQUET_PRE_BUFFER = "PARQUET_PRE_BUFFER";
+  const std::string PARQUET_CACHE_HOLE_SIZE_LIMIT = "PARQUET_CACHE_HOLE_SIZE_LIMIT";
+  const std::string PARQUET_CACHE_RANGE_SIZE_LIMIT = "PARQUET_CACHE_RANGE_SIZE_LIMIT";
+  const std::string PARQUET_BUFFER_SIZE = "PARQUET_BUFFER_SIZE";
+  const std::string PARQUET_BUFFERED_STREAM = "PARQUET_BUFFERED_STREAM";
+  const std::string PARQUET_BATCH_SIZE = "PARQUET_BATCH_SIZE";
+  const std::string STRINGS_AS_SYMBOLS = "STRINGS_AS_SYMBOLS";
+  const std::string PARQUET_BLOOM_FILTER_NDV = "PARQUET_BLOOM_FILTER_NDV";
+  const std::string PARQUET_WRITE_PAGE_INDEX = "PARQUET_WRITE_PAGE_INDEX";
+  const std::string PARQUET_DATA_PAGE_SIZE = "PARQUET_DATA_PAGE_SIZE";
+  const std::string PARQUET_COMPRESSION_LEVEL = "PARQUET_COMPRESSION_LEVEL";
+  const std::string PARQUET_DICTIONARY_PAGE_SIZE_LIMIT = "PARQUET_DICTIONARY_PAGE_SIZE_LIMIT";
+  const std::string PARQUET_MAX_ROW_GROUP_LENGTH = "PARQUET_MAX_ROW_GROUP_LENGTH";
+  const std::string PARQUET_MULTITHREADED_WRITE = "PARQUET_MULTITHREADED_WRITE";
+  const std::string PARQUET_WRITE_THREADS = "PARQUET_WRITE_THREADS";
+  const std::string SYMBOLS_AS_DICTIONARY = "SYMBOLS_AS_DICTIONARY";
+  const std::string STRINGS_AS_FLAT = "STRINGS_AS_FLAT";
+  const std::string DECIMAL128_AS_SCALED_LONG = "DECIMAL128_AS_SCALED_LONG";
+  const std::string LIST_AS_FLAT = "LIST_AS_FLAT";
 
   // String options
   const std::string PARQUET_VERSION = "PARQUET_VERSION";
@@ -33,6 +54,12 @@ namespace Options
 
   // Dict options
   const std::string NULL_MAPPING = "NULL_MAPPING";
+  const std::string PARQUET_COLUMN_OPTIONS = "PARQUET_COLUMN_OPTIONS";
+
+  // List options
+  const std::string FILTER = "FILTER";
+  const std::string COLUMNS = "COLUMNS";
+  const std::string PARQUET_BLOOM_FILTER_COLUMNS = "PARQUET_BLOOM_FILTER_COLUMNS";
 
   // Null mapping options
   const std::string NM_BOOLEAN = "bool";
@@ -62,6 +89,12 @@ namespace Options
   const std::string NM_MONTH_INTERVAL = "month_interval";
   const std::string NM_DAY_TIME_INTERVAL = "day_time_interval";
 
+  // Parquet column options
+  const std::string PC_COMPRESSION = "COMPRESSION";
+  const std::string PC_COMPRESSION_LEVEL = "COMPRESSION_LEVEL";
+  const std::string PC_DICTIONARY = "DICTIONARY";
+  const std::string PC_ENCODING = "ENCODING";
+
   const static std::set<std::string> int_options = {
     ARROW_CHUNK_ROWS,
     PARQUET_CHUNK_SIZE,
@@ -69,7 +102,27 @@ namespace Options
     PARQUET_MULTITHREADED_READ,
     USE_MMAP,
     DECIMAL128_AS_DOUBLE,
-    WITH_NULL_BITMAP
+    WITH_NULL_BITMAP,
+    MULTITHREADED_CONVERSION,
+    PARQUET_PRE_BUFFER,
+    PARQUET_CACHE_HOLE_SIZE_LIMIT,
+    PARQUET_CACHE_RANGE_SIZE_LIMIT,
+    PARQUET_BUFFER_SIZE,
+    PARQUET_BUFFERED_STREAM,
+    PARQUET_BATCH_SIZE,
+    STRINGS_AS_SYMBOLS,
+    PARQUET_BLOOM_FILTER_NDV,
+    PARQUET_WRITE_PAGE_INDEX,
+    PARQUET_DATA_PAGE_SIZE,
+    PARQUET_COMPRESSION_LEVEL,
+    PARQUET_DICTIONARY_PAGE_SIZE_LIMIT,
+    PARQUET_MAX_ROW_GROUP_LENGTH,
+    PARQUET_MULTITHREADED_WRITE,
+    PARQUET_WRITE_THREADS,
+    SYMBOLS_AS_DICTIONARY,
+    STRINGS_AS_FLAT,
+    DECIMAL128_AS_SCALED_LONG,
+    LIST_AS_FLAT
   };
   const static std::set<std::string> string_options = {
     PARQUET_VERSION,
@@ -77,6 +130,12 @@ namespace Options
   };
   const static std::set<std::string> dict_options = {
     NULL_MAPPING,
+    PARQUET_COLUMN_OPTIONS,
+  };
+  const static std::set<std::string> list_options = {
+    FILTER,
+    COLUMNS,
+    PARQUET_BLOOM_FILTER_COLUMNS,
   };
 
   struct NullMapping
@@ -145,6 +204,52 @@ namespace Options
       int64_t day_time_interval_null;
   };
 
+  // Filter predicates
+  enum class FilterOperator
+  {
+      EQUAL
+    , LESS
+    , LESS_EQUAL
+    , GREATER
+    , GREATER_EQUAL
+    , WITHIN
+    , IN
+  };
+
+  // A single filter value, held in its kdb representation.  Integral and
+  // temporal atoms are held as int64 (temporals use the same units as the kdb
+  // list that column is read into), floating point atoms as double and
+  // symbols/strings as std::string.
+  struct FilterValue
+  {
+    enum Kind { INTEGER, REAL, STRING };
+
+    Kind kind;
+    signed char kdb_type;
+    int64_t integer;
+    double real;
+    std::string string;
+  };
+
+  struct FilterPredicate
+  {
+    std::string column;
+    FilterOperator op;
+    std::vector<FilterValue> values;
+  };
+
+  // Parquet writer settings for a single field, empty strings and have_ flags
+  // indicate settings which weren't specified
+  struct ParquetColumnOptions
+  {
+    std::string compression;
+    bool have_compression_level = false;
+    int64_t compression_level = 0;
+    bool have_dictionary = false;
+    bool dictionary = true;
+    std::string encoding;
+  };
+
 } // namespace Options
 
 // Helper class for reading dictionary of options
@@ -153,17 +258,21 @@ namespace Options
 // Dictionary value:  KS or
 //                    KJ or
 //                    XD or
-//                    0 of -KS|-KJ|XD|KC
+//                    0 of -KS|-KJ|XD|KC|KS|0
 class KdbOptions
 {
 private:
   Options::NullMapping null_mapping_options;
+  std::vector<Options::FilterPredicate> filter_predicates;
   std::map<std::string, std::string> string_options;
   std::map<std::string, int64_t> int_options;
+  std::map<std::string, std::vector<std::string>> symbol_list_options;
+  std::map<std::string, Options::ParquetColumnOptions> parquet_column_options;
 
   const std::set<std::string>& supported_string_options;
   const std::set<std::string>& supported_int_options;
   const std::set<std::string>& supported_dict_options;
+  const std::set<std::string>& supported_list_options;
   std::set<std::string> supported_null_mapping_options;
 
   using NullMappingHandler = void ( KdbOptions::* )( const std::string&, K );
@@ -182,8 +291,20 @@ private:
 
   void PopulateNullMappingOptions( long long index, K dict );
 
+  void PopulateParquetColumnSetting( const std::string& column, const std::string& setting, K values, long long index );
+
+  void PopulateParquetColumnOptions( K dict );
+
   void PopulateDictOptions( K keys, K values );
 
+  Options::FilterValue MakeFilterValue( K atom, long long index );
+
+  void PopulateFilterValues( Options::FilterPredicate& predicate, K value );
+
+  void PopulateFilterPredicate( K predicate );
+
+  void PopulateFilterOptions( K filter );
+
   void PopulateMixedOptions(K keys, K values);
 
 public:
@@ -198,7 +319,8 @@ public:
           K options
         , const std::set<std::string>& supported_string_options_
         , const std::set<std::string>& supported_int_options_
-        , const std::set<std::string>& supported_dict_options_ = Options::dict_options );
+        , const std::set<std::string>& supported_dict_options_ = Options::dict_options
+        , const std::set<std::string>& supported_list_options_ = Options::list_options );
 
   template<arrow::Type::type TypeId>
   inline void HandleNullMapping( const std::string& key, K value );
@@ -209,9 +331,19 @@ public:
     null_mapping = null_mapping_options;
   }
 
+  void GetFilterOptions( std::vector<Options::FilterPredicate>& predicates ) const{
+    predicates = filter_predicates;
+  }
+
+  void GetParquetColumnOptions( std::map<std::string, Options::ParquetColumnOptions>& column_options ) const{
+    column_options = parquet_column_options;
+  }
+
   bool GetStringOption(const std::string key, std::string& result) const;
 
   bool GetIntOption(const std::string key, int64_t& result) const;
+
+  bool GetSymbolListOption(const std::string key, std::vector<std::string>& result) const;
 };
 
 inline void null_mapping_error( const std::string& key, K value )
@@ -0,0 +1,437 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef ARROWKDB_DATASET
+#include <filesystem>
+
+#include <arrow/compute/api.h>
+#include <arrow/dataset/api.h>
+#include <arrow/filesystem/api.h>
+#include <parquet/exception.h>
+#endif
+
+#include "ParquetDataset.h"
+#include "ArrayReader.h"
+#include "HelperFunctions.h"
+#include "KdbOptions.h"
+
+
+#ifdef ARROWKDB_DATASET
+
+namespace kx {
+namespace arrowkdb {
+
+namespace {
+
+namespace cp = arrow::compute;
+namespace ds = arrow::dataset;
+
+using Options::FilterValue;
+using Options::FilterOperator;
+using Options::FilterPredicate;
+
+const static std::string hive_null_partition = "__HIVE_DEFAULT_PARTITION__";
+
+// Decodes the %XX escapes in a partition value, as arrow's HivePartitioning
+// does by default.  Values with invalid escapes are returned unchanged.
+std::string UriDecode(const std::string& value)
+{
+  auto hex = [](char c) {
+    if (c >= '0' && c <= '9')
+      return c - '0';
+    if (c >= 'a' && c <= 'f')
+      return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+      return c - 'A' + 10;
+    return -1;
+  };
+
+  std::string result;
+  for (size_t i = 0; i < value.length(); ++i) {
+    if (value[i] != '%') {
+      result.push_back(value[i]);
+      continue;
+    }
+    if (i + 2 >= value.length() || hex(value[i + 1]) < 0 || hex(value[i + 2]) < 0)
+      return value;
+    result.push_back(static_cast<char>(hex(value[i + 1]) * 16 + hex(value[i + 2])));
+    i += 2;
+  }
+
+  return result;
+}
+
+// Splits a relative directory path into its key=value segments, decoding the
+// values
+std::vector<std::pair<std::string, std::string>> ParsePartitionSegments(const std::string& path)
+{
+  std::vector<std::pair<std::string, std::string>> result;
+  size_t start = 0;
+  while (start < path.length()) {
+    auto end = path.find('/', start);
+    if (end == std::string::npos)
+      end = path.length();
+    auto segment = path.substr(start, end - start);
+    auto equals = segment.find('=');
+    if (equals != std::string::npos)
+      result.push_back({ segment.substr(0, equals), UriDecode(segment.substr(equals + 1)) });
+    start = end + 1;
+  }
+
+  return result;
+}
+
+// Parses a kdb (2024.01.02) or ISO (2024-01-02) date into days since the unix
+// epoch
+bool ParseDate(const std::string& value, int32_t& days)
+{
+  if (value.length() != 10 || value[4] != value[7] || (value[4] != '.' && value[4] != '-'))
+    return false;
+  for (auto i : { 0, 1, 2, 3, 5, 6, 8, 9 })
+    if (!isdigit(static_cast<unsigned char>(value[i])))
+      return false;
+
+  int32_t y = std::stoi(value.substr(0, 4));
+  int32_t m = std::stoi(value.substr(5, 2));
+  int32_t d = std::stoi(value.substr(8, 2));
+  if (m < 1 || m > 12 || d < 1)
+    return false;
+
+  // Reject days past the end of the month, such as 2024-02-30, rather than
+  // rolling them over into the next month
+  static const int32_t month_days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+  const bool leap_year = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+  if (d > month_days[m - 1] + (m == 2 && leap_year))
+    return false;
+
+  // Days from civil date, proleptic gregorian calendar
+  y -= m <= 2;
+  const int32_t era = (y >= 0 ? y : y - 399) / 400;
+  const int32_t yoe = y - era * 400;
+  const int32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  days = era * 146097 + doe - 719468;
+
+  return true;
+}
+
+bool ParseInteger(const std::string& value, int64_t& integer)
+{
+  if (value.empty())
+    return false;
+  size_t pos = 0;
+  try {
+    integer = std::stoll(value, &pos);
+  } catch (std::exception&) {
+    return false;
+  }
+
+  return pos == value.length();
+}
+
+// Infers the type of each hive partition key from all the values it takes
+std::shared_ptr<arrow::Schema> InferPartitionSchema(const std::vector<std::string>& directories)
+{
+  std::vector<std::string> keys;
+  std::map<std::string, std::vector<std::string>> values;
+  for (const auto& directory : directories) {
+    for (const auto& segment : ParsePartitionSegments(directory)) {
+      if (values.find(segment.first) == values.end())
+        keys.push_back(segment.first);
+      if (segment.second != hive_null_partition)
+        values[segment.first].push_back(segment.second);
+    }
+  }
+
+  arrow::FieldVector fields;
+  for (const auto& key : keys) {
+    bool all_dates = true;
+    bool all_integers = true;
+    for (const auto& value : values[key]) {
+      int32_t days = 0;
+      int64_t integer = 0;
+      all_dates = all_dates && ParseDate(value, days);
+      all_integers = all_integers && ParseInteger(value, integer);
+    }
+
+    if (!values[key].empty() && all_dates)
+      fields.push_back(arrow::field(key, arrow::date32()));
+    else if (!values[key].empty() && all_integers)
+      fields.push_back(arrow::field(key, arrow::int64()));
+    else
+      fields.push_back(arrow::field(key, arrow::utf8()));
+  }
+
+  return arrow::schema(fields);
+}
+
+// Hive style partitioning using the inferred partition schema.  Unlike
+// arrow's HivePartitioning this accepts kdb formatted dates.
+std::shared_ptr<ds::Partitioning> MakePartitioning(std::shared_ptr<arrow::Schema> partition_schema)
+{
+  auto parse = [partition_schema](const std::string& path) -> arrow::Result<cp::Expression> {
+    std::vector<cp::Expression> expressions;
+    for (const auto& segment : ParsePartitionSegments(path)) {
+      auto field = partition_schema->GetFieldByName(segment.first);
+      if (!field)
+        continue;
+
+      auto field_ref = cp::field_ref(segment.first);
+      if (segment.second == hive_null_partition) {
+        expressions.push_back(cp::is_null(field_ref));
+      } else if (field->type()->id() == arrow::Type::DATE32) {
+        int32_t days = 0;
+        ParseDate(segment.second, days);
+        expressions.push_back(cp::equal(field_ref, cp::literal(std::make_shared<arrow::Date32Scalar>(days))));
+      } else if (field->type()->id() == arrow::Type::INT64) {
+        int64_t integer = 0;
+        ParseInteger(segment.second, integer);
+        expressions.push_back(cp::equal(field_ref, cp::literal(integer)));
+      } else {
+        expressions.push_back(cp::equal(field_ref, cp::literal(segment.second)));
+      }
+    }
+
+    return cp::and_(expressions);
+  };
+
+  return std::make_shared<ds::FunctionPartitioning>(partition_schema, parse);
+}
+
+// Converts a filter value from its kdb representation to an arrow literal.
+// The field's datatype, if known, picks between the arrow types which share a
+// kdb type.
+cp::Expression MakeLiteral(const FilterValue& value, std::shared_ptr<arrow::DataType> datatype)
+{
+  switch (value.kind) {
+  case FilterValue::REAL:
+    return cp::literal(value.real);
+  case FilterValue::STRING:
+    return cp::literal(value.string);
+  default:
+    break;
+  }
+
+  switch (-value.kdb_type) {
+  case KB:
+    return cp::literal(value.integer != 0);
+  case KD:
+  {
+    TemporalConversion tc(arrow::date32());
+    return cp::literal(std::make_shared<arrow::Date32Scalar>(tc.KdbToArrow(static_cast<int32_t>(value.integer))));
+  }
+  case KP:
+  {
+    auto datatype = arrow::timestamp(arrow::TimeUnit::NANO);
+    TemporalConversion tc(datatype);
+    return cp::literal(std::make_shared<arrow::TimestampScalar>(tc.KdbToArrow(value.integer), datatype));
+  }
+  case KT:
+    return cp::literal(std::make_shared<arrow::Time32Scalar>(static_cast<int32_t>(value.integer), arrow::time32(arrow::TimeUnit::MILLI)));
+  case KN:
+    // Nanosecond literals so the comparison casts the field losslessly
+    if (datatype && datatype->id() == arrow::Type::DURATION)
+      return cp::literal(std::make_shared<arrow::DurationScalar>(value.integer, arrow::duration(arrow::TimeUnit::NANO)));
+    else
+      return cp::literal(std::make_shared<arrow::Time64Scalar>(value.integer, arrow::time64(arrow::TimeUnit::NANO)));
+  default:
+    return cp::literal(value.integer);
+  }
+}
+
+// Converts the filter predicates to an arrow compute expression.  The
+// dataset uses it both to prune partitions and row groups and to filter the
+// rows which are read.
+cp::Expression MakeFilterExpression(const std::vector<FilterPredicate>& predicates, std::shared_ptr<arrow::Schema> schema)
+{
+  std::vector<cp::Expression> expressions;
+  for (const auto& predicate : predicates) {
+    auto field_ref = cp::field_ref(predicate.column);
+    auto field = schema->GetFieldByName(predicate.column);
+    auto datatype = field ? field->type() : nullptr;
+    const auto& values = predicate.values;
+    switch (predicate.op) {
+    case FilterOperator::EQUAL:
+      expressions.push_back(cp::equal(field_ref, MakeLiteral(values[0], datatype)));
+      break;
+    case FilterOperator::LESS:
+      expressions.push_back(cp::less(field_ref, MakeLiteral(values[0], datatype)));
+      break;
+    case FilterOperator::LESS_EQUAL:
+      expressions.push_back(cp::less_equal(field_ref, MakeLiteral(values[0], datatype)));
+      break;
+    case FilterOperator::GREATER:
+      expressions.push_back(cp::greater(field_ref, MakeLiteral(values[0], datatype)));
+      break;
+    case FilterOperator::GREATER_EQUAL:
+      expressions.push_back(cp::greater_equal(field_ref, MakeLiteral(values[0], datatype)));
+      break;
+    case FilterOperator::WITHIN:
+      expressions.push_back(cp::and_(cp::greater_equal(field_ref, MakeLiteral(values[0], datatype)), cp::less_equal(field_ref, MakeLiteral(values[1], datatype))));
+      break;
+    case FilterOperator::IN:
+    {
+      std::vector<cp::Expression> equals;
+      for (const auto& value : values)
+        equals.push_back(cp::equal(field_ref, MakeLiteral(value, datatype)));
+      expressions.push_back(cp::or_(equals));
+      break;
+    }
+    }
+  }
+
+  return cp::and_(expressions);
+}
+
+// Returns true if a file or directory name should be excluded from the
+// dataset, matching arrow's default selector_ignore_prefixes.  Either path
+// separator is accepted since a local Windows path may use '\\'.
+bool IsIgnored(const std::string& path, const std::string& base_dir)
+{
+  size_t start = base_dir.length();
+  while (start < path.length()) {
+    if (path[start] == '/' || path[start] == '\\') {
+      ++start;
+      continue;
+    }
+    if (path[start] == '.' || path[start] == '_')
+      return true;
+    auto end = path.find_first_of("/\\", start);
+    if (end == std::string::npos)
+      break;
+    start = end + 1;
+  }
+
+  return false;
+}
+
+// Builds a kdb table from the field names and a mixed list of column data.
+// Consumes a reference to data.
+K MakeKdbTable(const std::vector<std::string>& names, K data)
+{
+  K keys = ktn(KS, names.size());
+  for (size_t i = 0; i < names.size(); ++i)
+    kS(keys)[i] = ss((S)names[i].c_str());
+
+  return xT(xD(keys, data));
+}
+
+} // namespace
+
+} // namespace arrowkdb
+} // namespace kx
+
+#endif // ARROWKDB_DATASET
+
+
+K readParquetDataset(K dataset_dir, K options)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (!kx::arrowkdb::IsKdbString(dataset_dir))
+    return krr((S)"dataset_dir not 11h or 0 of 10h");
+
+#ifdef ARROWKDB_DATASET
+  namespace ds = arrow::dataset;
+
+  // Parse the options
+  auto read_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
+
+  // Type mapping overrides
+  kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
+
+  // A dataset is returned as a table so string and list columns can't use the
+  // flat forms
+  type_overrides.strings_as_flat = 0;
+  type_overrides.list_as_flat = 0;
+
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
+  // Discover the files below the root directory
+  std::string uri_or_path = kx::arrowkdb::GetKdbString(dataset_dir);
+  if (uri_or_path.find("://") == std::string::npos)
+    uri_or_path = std::filesystem::absolute(uri_or_path).generic_string();
+
+  std::string base_dir;
+  std::shared_ptr<arrow::fs::FileSystem> filesystem;
+  PARQUET_ASSIGN_OR_THROW(filesystem, arrow::fs::FileSystemFromUriOrPath(uri_or_path, &base_dir));
+  while (base_dir.length() > 1 && base_dir.back() == '/')
+    base_dir.pop_back();
+
+  arrow::fs::FileSelector selector;
+  selector.base_dir = base_dir;
+  selector.recursive = true;
+  std::vector<arrow::fs::FileInfo> file_infos;
+  PARQUET_ASSIGN_OR_THROW(file_infos, filesystem->GetFileInfo(selector));
+
+  std::vector<std::string> paths;
+  std::vector<std::string> directories;
+  for (const auto& file_info : file_infos) {
+    if (!file_info.IsFile() || kx::arrowkdb::IsIgnored(file_info.path(), base_dir))
+      continue;
+    paths.push_back(file_info.path());
+    auto directory = file_info.dir_name();
+    directories.push_back(directory.length() > base_dir.length() ? directory.substr(base_dir.length() + 1) : "");
+  }
+  if (paths.empty())
+    return krr((S)"no files found in dataset_dir");
+
+  // Hive style partitioning
+  ds::FileSystemFactoryOptions factory_options;
+  factory_options.partition_base_dir = base_dir;
+  factory_options.partitioning = kx::arrowkdb::MakePartitioning(kx::arrowkdb::InferPartitionSchema(directories));
+
+  auto format = std::make_shared<ds::ParquetFileFormat>();
+  std::shared_ptr<ds::DatasetFactory> factory;
+  PARQUET_ASSIGN_OR_THROW(factory, ds::FileSystemDatasetFactory::Make(filesystem, paths, format, factory_options));
+  std::shared_ptr<ds::Dataset> dataset;
+  PARQUET_ASSIGN_OR_THROW(dataset, factory->Finish());
+
+  // Scan the fragments in parallel, applying the column projection and filter
+  std::shared_ptr<ds::ScannerBuilder> scanner_builder;
+  PARQUET_ASSIGN_OR_THROW(scanner_builder, dataset->NewScan());
+  PARQUET_THROW_NOT_OK(scanner_builder->UseThreads(true));
+
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+  if (!column_names.empty()) {
+    kx::arrowkdb::GetFieldIndices(dataset->schema(), column_names);
+    PARQUET_THROW_NOT_OK(scanner_builder->Project(column_names));
+  }
+
+  std::vector<kx::arrowkdb::Options::FilterPredicate> filter;
+  read_options.GetFilterOptions(filter);
+  if (!filter.empty())
+    PARQUET_THROW_NOT_OK(scanner_builder->Filter(kx::arrowkdb::MakeFilterExpression(filter, dataset->schema())));
+
+  std::shared_ptr<ds::Scanner> scanner;
+  PARQUET_ASSIGN_OR_THROW(scanner, scanner_builder->Finish());
+  std::shared_ptr<arrow::Table> table;
+  PARQUET_ASSIGN_OR_THROW(table, scanner->ToTable());
+
+  // Convert the dataset to a kdb table
+  const auto schema = table->schema();
+  const auto names = schema->field_names();
+  K data = kx::arrowkdb::MakeKdbTable(names, kx::arrowkdb::ReadChunkedArrays(table->columns(), type_overrides, multithreaded_conversion));
+
+  int64_t with_null_bitmap = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap);
+  if (with_null_bitmap) {
+    K bitmap = kx::arrowkdb::MakeKdbTable(names, kx::arrowkdb::ReadChunkedArraysNullBitmap(table->columns(), type_overrides, multithreaded_conversion));
+    K array = data;
+    data = ktn(0, 2);
+    kK(data)[0] = array;
+    kK(data)[1] = bitmap;
+  }
+
+  return data;
+#else
+  return krr((S)"arrowkdb built without arrow dataset support");
+#endif
+
+  KDB_EXCEPTION_CATCH;
+}
@@ -0,0 +1,66 @@
+#ifndef __PARQUET_DATASET_H__
+#define __PARQUET_DATASET_H__
+
+#include "ArrowKdb.h"
+
+
+extern "C"
+{
+  /**
+   * @brief Reads a directory of parquet files as a single dataset using
+   * arrow::dataset, returning a kdb table.  All the files below the directory
+   * are read (ignoring those whose names begin with `.` or `_`) and must share
+   * a compatible schema.
+   *
+   * Hive style partition directories of the form `key=value` add a column for
+   * each key, after the files' own columns.  The partition column type is
+   * inferred from its values: dates (`2024.01.02` or `2024-01-02`) become
+   * date32, integers int64 and anything else utf8.
+   *
+   * The fragments (files) are scanned in parallel using the arrow CPU thread
+   * pool, then converted to kdb in one pass.
+   *
+   * Supported options:
+   *
+   * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
+   * default type mapping for the arrow decimal128 datatype and instead
+   * represent it as a double (9h).  Default 0.
+   *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * NULL_MAPPING (dict) - Sub-dictionary of null mapping datatypes and values.
+   *
+   * WITH_NULL_BITMAP (long) - Flag indicating whether to return the data
+   * values and the null bitmap as separate tables.  Default 0.
+   *
+   * FILTER (list) - Predicate or list of predicates, each of the form
+   * (operator;column;value).  Predicates on partition columns prune whole
+   * directories, others skip row groups using their statistics.  Unlike the
+   * single file readers the predicates are then applied exactly to the rows.
+   *
+   * COLUMNS (symbol list) - Names of the fields (including partition fields)
+   * to read, in the order they should be returned.
+   *
+   * @param dataset_dir String name of the dataset's root directory
+   * @options           Dictionary of options or generic null (::) to use
+   * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
+   * mixed list of -7|-11|4|0h.
+   * @return            kdb table, or a two item list of the table and its null
+   * bitmap table if WITH_NULL_BITMAP is set
+  */
+  EXP K readParquetDataset(K dataset_dir, K options);
+}
+
+#endif // __PARQUET_DATASET_H__
@@ -0,0 +1,593 @@
+#include <algorithm>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <arrow/io/caching.h>
+#include <arrow/io/file.h>
+#include <arrow/table.h>
+#include <arrow/util/config.h>
+#include <arrow/util/thread_pool.h>
+#include <parquet/arrow/schema.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
+
+#include "ParquetFile.h"
+#include "HelperFunctions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+namespace {
+
+// File identity, change and modification times and size, used to detect a
+// changed file.  Comparing the inode and ctime as well as the mtime and size
+// catches a file being replaced (e.g. by a rename) with one of the same size
+// whose mtime has been preserved.
+struct FileStat
+{
+  int64_t mtime = -1;
+  int64_t ctime = -1;
+  int64_t size = -1;
+  uint64_t inode = 0;
+
+  bool valid() const { return mtime >= 0; }
+
+  bool operator==(const FileStat& other) const
+  {
+    return mtime == other.mtime && ctime == other.ctime && size == other.size && inode == other.inode;
+  }
+  bool operator!=(const FileStat& other) const { return !(*this == other); }
+};
+
+#ifdef _WIN32
+typedef struct _stat64 StatBuffer;
+#else
+typedef struct stat StatBuffer;
+#endif
+
+FileStat ToFileStat(const StatBuffer& st)
+{
+  FileStat result;
+#ifdef _WIN32
+  result.mtime = static_cast<int64_t>(st.st_mtime) * 1000000000LL;
+  result.ctime = static_cast<int64_t>(st.st_ctime) * 1000000000LL;
+#elif defined(__APPLE__)
+  result.mtime = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+  result.ctime = static_cast<int64_t>(st.st_ctimespec.tv_sec) * 1000000000LL + st.st_ctimespec.tv_nsec;
+#else
+  result.mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+  result.ctime = static_cast<int64_t>(st.st_ctim.tv_sec) * 1000000000LL + st.st_ctim.tv_nsec;
+#endif
+  result.size = st.st_size;
+  result.inode = st.st_ino;
+
+  return result;
+}
+
+FileStat GetFileStat(const std::string& path)
+{
+  StatBuffer st;
+#ifdef _WIN32
+  if (_stat64(path.c_str(), &st) == 0)
+#else
+  if (stat(path.c_str(), &st) == 0)
+#endif
+    return ToFileStat(st);
+
+  return FileStat();
+}
+
+FileStat GetFileStat(int fd)
+{
+  StatBuffer st;
+#ifdef _WIN32
+  if (_fstat64(fd, &st) == 0)
+#else
+  if (fstat(fd, &st) == 0)
+#endif
+    return ToFileStat(st);
+
+  return FileStat();
+}
+
+// Least recently used cache of parsed parquet footers and the arrow schemas
+// derived from them, keyed on file path.  Limited to both a number of files
+// and a total footer size, since the footers of wide files with many row
+// groups can be several MB each.
+class MetadataCache
+{
+public:
+  struct Entry
+  {
+    FileStat stat;
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    std::shared_ptr<arrow::Schema> schema;
+  };
+
+private:
+  const static size_t capacity = 256;
+  // Budget for the serialized size of the cached footers.  The parsed
+  // metadata is larger but roughly in proportion.
+  const static int64_t capacity_bytes = 64LL * 1024 * 1024;
+
+  std::mutex mutex;
+  int64_t total_bytes = 0;
+  std::list<std::string> lru; // most recently used first
+  std::unordered_map<std::string, std::pair<Entry, std::list<std::string>::iterator>> entries;
+
+public:
+  // Returns true and populates result if the path is cached and the file is
+  // unchanged.  Stale entries are evicted.
+  bool Find(const std::string& path, const FileStat& stat, Entry& result)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = entries.find(path);
+    if (it == entries.end())
+      return false;
+
+    if (it->second.first.stat != stat) {
+      total_bytes -= Bytes(it->second.first);
+      lru.erase(it->second.second);
+      entries.erase(it);
+      return false;
+    }
+
+    lru.splice(lru.begin(), lru, it->second.second);
+    result = it->second.first;
+    return true;
+  }
+
+  void Insert(const std::string& path, const Entry& entry)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // A footer larger than the whole budget would only evict everything else
+    const auto bytes = Bytes(entry);
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+      total_bytes -= Bytes(it->second.first);
+      lru.erase(it->second.second);
+      entries.erase(it);
+    }
+    if (bytes > capacity_bytes)
+      return;
+
+    lru.push_front(path);
+    entries[path] = std::make_pair(entry, lru.begin());
+    total_bytes += bytes;
+    while (entries.size() > capacity || total_bytes > capacity_bytes) {
+      auto oldest = entries.find(lru.back());
+      total_bytes -= Bytes(oldest->second.first);
+      entries.erase(oldest);
+      lru.pop_back();
+    }
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    entries.clear();
+    lru.clear();
+    total_bytes = 0;
+  }
+
+private:
+  static int64_t Bytes(const Entry& entry)
+  {
+    return entry.metadata ? entry.metadata->size() : 0;
+  }
+};
+
+MetadataCache& GetMetadataCache()
+{
+  static MetadataCache cache;
+  return cache;
+}
+
+// Opens a file and sets stat to that of the file which was opened, so that a
+// footer cached for a file which has since been replaced is never used.  A
+// memory mapped file doesn't expose its descriptor, so instead the path is
+// checked to be unchanged across the open, otherwise stat is left invalid.
+std::shared_ptr<arrow::io::RandomAccessFile> OpenInputFile(const std::string& path, bool use_mmap, FileStat& stat)
+{
+  std::shared_ptr<arrow::io::RandomAccessFile> infile;
+  if (use_mmap) {
+    auto before = GetFileStat(path);
+    PARQUET_ASSIGN_OR_THROW(
+      infile,
+      arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ));
+    stat = GetFileStat(path);
+    if (stat != before)
+      stat = FileStat();
+  } else {
+    std::shared_ptr<arrow::io::ReadableFile> file;
+    PARQUET_ASSIGN_OR_THROW(
+      file,
+      arrow::io::ReadableFile::Open(path, arrow::default_memory_pool()));
+    stat = GetFileStat(file->file_descriptor());
+    infile = file;
+  }
+
+  return infile;
+}
+
+parquet::ReaderProperties GetReaderProperties(const KdbOptions& options)
+{
+  auto properties = parquet::default_reader_properties();
+
+  int64_t buffered_stream = 0;
+  options.GetIntOption(Options::PARQUET_BUFFERED_STREAM, buffered_stream);
+  if (buffered_stream)
+    properties.enable_buffered_stream();
+
+  int64_t buffer_size = 0;
+  if (options.GetIntOption(Options::PARQUET_BUFFER_SIZE, buffer_size))
+    properties.set_buffer_size(buffer_size);
+
+  return properties;
+}
+
+parquet::ArrowReaderProperties GetArrowReaderProperties(const KdbOptions& options, const parquet::FileMetaData& metadata)
+{
+  auto properties = parquet::default_arrow_reader_properties();
+
+  // Read the top level string columns as dictionary arrays so that each
+  // distinct value only has to be interned as a symbol once per chunk
+  int64_t strings_as_symbols = 0;
+  options.GetIntOption(Options::STRINGS_AS_SYMBOLS, strings_as_symbols);
+  if (strings_as_symbols) {
+    const auto schema = metadata.schema();
+    for (auto i = 0; i < schema->num_columns(); ++i) {
+      const auto column = schema->Column(i);
+      if (column->physical_type() == parquet::Type::BYTE_ARRAY && column->logical_type()->is_string() && schema->GetColumnRoot(i) == column->schema_node().get())
+        properties.set_read_dictionary(i, true);
+    }
+  }
+
+  int64_t pre_buffer = 0;
+  if (options.GetIntOption(Options::PARQUET_PRE_BUFFER, pre_buffer))
+    properties.set_pre_buffer(pre_buffer);
+
+  // Coalescing of the pre-buffered reads
+  auto cache_options = arrow::io::CacheOptions::Defaults();
+  bool have_cache_options = options.GetIntOption(Options::PARQUET_CACHE_HOLE_SIZE_LIMIT, cache_options.hole_size_limit);
+  have_cache_options |= options.GetIntOption(Options::PARQUET_CACHE_RANGE_SIZE_LIMIT, cache_options.range_size_limit);
+  if (have_cache_options)
+    properties.set_cache_options(cache_options);
+
+  int64_t batch_size = 0;
+  if (options.GetIntOption(Options::PARQUET_BATCH_SIZE, batch_size))
+    properties.set_batch_size(batch_size);
+
+  return properties;
+}
+
+// Converts a PARQUET_COLUMN_OPTIONS encoding name to a parquet encoding.  The
+// dictionary encodings are selected using the DICTIONARY setting instead.
+parquet::Encoding::type GetParquetEncoding(const std::string& encoding)
+{
+  static const std::map<std::string, parquet::Encoding::type> encodings = {
+      { "PLAIN", parquet::Encoding::PLAIN }
+    , { "RLE", parquet::Encoding::RLE }
+    , { "DELTA_BINARY_PACKED", parquet::Encoding::DELTA_BINARY_PACKED }
+    , { "DELTA_LENGTH_BYTE_ARRAY", parquet::Encoding::DELTA_LENGTH_BYTE_ARRAY }
+    , { "DELTA_BYTE_ARRAY", parquet::Encoding::DELTA_BYTE_ARRAY }
+    , { "BYTE_STREAM_SPLIT", parquet::Encoding::BYTE_STREAM_SPLIT } };
+
+  auto it = encodings.find(encoding);
+  if (it == encodings.end())
+    throw KdbOptions::InvalidOption("Unsupported PARQUET_COLUMN_OPTIONS encoding '" + encoding + "'");
+
+  return it->second;
+}
+
+// Returns the dotted paths of the parquet leaf columns which a
+// PARQUET_COLUMN_OPTIONS key refers to.  The key is either the name of a top
+// level field, selecting all of its leaf columns, or the dotted path of a
+// single leaf column of a nested field.
+std::vector<std::string> GetLeafColumnPaths(const parquet::SchemaDescriptor& parquet_schema, const std::string& name)
+{
+  std::vector<std::string> result;
+  for (auto i = 0; i < parquet_schema.num_columns(); ++i) {
+    auto path = parquet_schema.Column(i)->path()->ToDotString();
+    if (path == name || parquet_schema.GetColumnRoot(i)->name() == name)
+      result.push_back(path);
+  }
+
+  return result;
+}
+
+void GetLeafColumns(const parquet::arrow::SchemaField& field, std::vector<int>& leaves)
+{
+  if (field.is_leaf())
+    leaves.push_back(field.column_index);
+  for (const auto& child : field.children)
+    GetLeafColumns(child, leaves);
+}
+
+} // namespace
+
+std::unique_ptr<parquet::arrow::FileReader> OpenParquetFile(const std::string& path, const KdbOptions& options)
+{
+  // Use multi threading
+  int64_t parquet_multithreaded_read = 0;
+  options.GetIntOption(Options::PARQUET_MULTITHREADED_READ, parquet_multithreaded_read);
+
+  // Use memmap
+  int64_t use_mmap = 0;
+  options.GetIntOption(Options::USE_MMAP, use_mmap);
+
+  // Reuse the parsed footer if the opened file is unchanged
+  FileStat stat;
+  auto infile = OpenInputFile(path, use_mmap, stat);
+  MetadataCache::Entry entry;
+  bool cached = stat.valid() && GetMetadataCache().Find(path, stat, entry);
+
+  auto parquet_reader = parquet::ParquetFileReader::Open(infile, GetReaderProperties(options), entry.metadata);
+  const auto metadata = parquet_reader->metadata();
+  if (!cached && stat.valid()) {
+    entry.stat = stat;
+    entry.metadata = metadata;
+    GetMetadataCache().Insert(path, entry);
+  }
+
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  PARQUET_THROW_NOT_OK(parquet::arrow::FileReader::Make(arrow::default_memory_pool(), std::move(parquet_reader), GetArrowReaderProperties(options, *metadata), &reader));
+
+  reader->set_use_threads(parquet_multithreaded_read);
+
+  return reader;
+}
+
+std::unique_ptr<parquet::arrow::FileWriter> OpenParquetWriter(const std::string& path, std::shared_ptr<arrow::Schema> schema, const KdbOptions& options, std::shared_ptr<arrow::internal::ThreadPool>& thread_pool)
+{
+  // Set writer properties
+  parquet::WriterProperties::Builder parquet_props_builder;
+  parquet::ArrowWriterProperties::Builder arrow_props_builder;
+
+  // Parquet version
+  std::string parquet_version;
+  options.GetStringOption(Options::PARQUET_VERSION, parquet_version);
+  if (parquet_version == "V2.0") {
+    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_0);
+    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
+  } else if (parquet_version == "V2.4") {
+    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_4);
+    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
+  } else if (parquet_version == "V2.6") {
+    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_6);
+    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
+  } else if (parquet_version == "V2.LATEST") {
+    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_LATEST);
+    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
+  } else {
+    // Not using v2.0 so map timestamp(ns) to timestamp(us) with truncation
+    arrow_props_builder.coerce_timestamps(arrow::TimeUnit::MICRO);
+    arrow_props_builder.allow_truncated_timestamps();
+  }
+
+  // Data page size
+  int64_t data_page_size = 0;
+  if (options.GetIntOption(Options::PARQUET_DATA_PAGE_SIZE, data_page_size))
+    parquet_props_builder.data_pagesize(data_page_size);
+
+  // Dictionary page size, beyond which a column chunk falls back to its
+  // non-dictionary encoding
+  int64_t dictionary_page_size_limit = 0;
+  if (options.GetIntOption(Options::PARQUET_DICTIONARY_PAGE_SIZE_LIMIT, dictionary_page_size_limit))
+    parquet_props_builder.dictionary_pagesize_limit(dictionary_page_size_limit);
+
+  // Maximum number of rows in a row group
+  int64_t max_row_group_length = 0;
+  if (options.GetIntOption(Options::PARQUET_MAX_ROW_GROUP_LENGTH, max_row_group_length))
+    parquet_props_builder.max_row_group_length(max_row_group_length);
+
+  // Compression level of the default codec
+  int64_t compression_level = 0;
+  if (options.GetIntOption(Options::PARQUET_COMPRESSION_LEVEL, compression_level))
+    parquet_props_builder.compression_level(static_cast<int>(compression_level));
+
+  // Per field codec, compression level, dictionary and encoding.  The writer
+  // applies them to leaf columns so a nested field's settings are applied to
+  // each of its leaves.
+  std::map<std::string, Options::ParquetColumnOptions> column_options;
+  options.GetParquetColumnOptions(column_options);
+  std::shared_ptr<parquet::SchemaDescriptor> parquet_schema;
+  if (!column_options.empty())
+    PARQUET_THROW_NOT_OK(parquet::arrow::ToParquetSchema(schema.get(), *parquet::default_writer_properties(), &parquet_schema));
+  for (const auto& column : column_options) {
+    const auto& name = column.first;
+    const auto& settings = column.second;
+    const auto paths = GetLeafColumnPaths(*parquet_schema, name);
+    if (paths.empty())
+      throw KdbOptions::InvalidOption("PARQUET_COLUMN_OPTIONS field '" + name + "' not found");
+    for (const auto& path : paths) {
+      if (!settings.compression.empty())
+        parquet_props_builder.compression(path, GetCompressionType(settings.compression));
+      if (settings.have_compression_level)
+        parquet_props_builder.compression_level(path, static_cast<int>(settings.compression_level));
+      if (settings.have_dictionary && settings.dictionary)
+        parquet_props_builder.enable_dictionary(path);
+      else if (settings.have_dictionary)
+        parquet_props_builder.disable_dictionary(path);
+      if (!settings.encoding.empty())
+        parquet_props_builder.encoding(path, GetParquetEncoding(settings.encoding));
+    }
+  }
+
+  // Page index (column index and offset index) used by FILTER to skip pages
+  int64_t write_page_index = 0;
+  options.GetIntOption(Options::PARQUET_WRITE_PAGE_INDEX, write_page_index);
+  if (write_page_index) {
+#if ARROW_VERSION_MAJOR >= 12
+    parquet_props_builder.enable_write_page_index();
+#else
+    throw KdbOptions::InvalidOption("PARQUET_WRITE_PAGE_INDEX requires libarrow 12 or later");
+#endif
+  }
+
+  // Bloom filters for point lookups on the chosen columns
+  std::vector<std::string> bloom_filter_columns;
+  options.GetSymbolListOption(Options::PARQUET_BLOOM_FILTER_COLUMNS, bloom_filter_columns);
+  for (const auto& name : bloom_filter_columns) {
+    if (schema->GetFieldIndex(name) < 0)
+      throw KdbOptions::InvalidOption("PARQUET_BLOOM_FILTER_COLUMNS field '" + name + "' not found");
+  }
+  if (!bloom_filter_columns.empty()) {
+#if ARROW_VERSION_MAJOR >= 21
+    parquet::BloomFilterOptions bloom_filter_options;
+    int64_t bloom_filter_ndv = 0;
+    if (options.GetIntOption(Options::PARQUET_BLOOM_FILTER_NDV, bloom_filter_ndv))
+      bloom_filter_options.ndv = static_cast<int32_t>(bloom_filter_ndv);
+    for (const auto& name : bloom_filter_columns)
+      parquet_props_builder.enable_bloom_filter(name, bloom_filter_options);
+#else
+    throw KdbOptions::InvalidOption("PARQUET_BLOOM_FILTER_COLUMNS requires libarrow 21 or later");
+#endif
+  }
+
+  // Parallel encoding of the column chunks within each buffered row group
+  int64_t multithreaded_write = 0;
+  options.GetIntOption(Options::PARQUET_MULTITHREADED_WRITE, multithreaded_write);
+  int64_t write_threads = 0;
+  if (options.GetIntOption(Options::PARQUET_WRITE_THREADS, write_threads) && write_threads <= 0)
+    throw KdbOptions::InvalidOption("PARQUET_WRITE_THREADS must be positive");
+#if ARROW_VERSION_MAJOR >= 11
+  if (multithreaded_write) {
+    // The column chunks are encoded on the arrow CPU thread pool unless
+    // PARQUET_WRITE_THREADS asks for a pool of this writer's own, capped at
+    // the number of cores, which the caller keeps alive until it is closed
+    arrow_props_builder.set_use_threads(true);
+    if (write_threads > 0) {
+      const auto max_threads = static_cast<int64_t>(std::max(1u, std::thread::hardware_concurrency()));
+      PARQUET_ASSIGN_OR_THROW(thread_pool, arrow::internal::ThreadPool::Make(static_cast<int>(std::min(write_threads, max_threads))));
+      arrow_props_builder.set_executor(thread_pool.get());
+    }
+  }
+#else
+  if (write_threads > 0)
+    throw KdbOptions::InvalidOption("PARQUET_WRITE_THREADS requires libarrow 11 or later");
+#endif
+
+  auto parquet_props = parquet_props_builder.compression(GetCompressionType(options))->build();
+  auto arrow_props = arrow_props_builder.build();
+
+  std::shared_ptr<arrow::io::FileOutputStream> outfile;
+  PARQUET_ASSIGN_OR_THROW(outfile, arrow::io::FileOutputStream::Open(path));
+
+  std::unique_ptr<parquet::arrow::FileWriter> writer;
+#if ARROW_VERSION_MAJOR >= 7
+  PARQUET_ASSIGN_OR_THROW(writer, parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(), outfile, parquet_props, arrow_props));
+#else
+  PARQUET_THROW_NOT_OK(parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(), outfile, parquet_props, arrow_props, &writer));
+#endif
+
+  return writer;
+}
+
+void WriteParquetTable(parquet::arrow::FileWriter* writer, const arrow::Table& table, int64_t chunk_size, bool multithreaded)
+{
+#if ARROW_VERSION_MAJOR >= 11
+  // Only buffered row groups are encoded in parallel, so write each chunk of
+  // rows as record batches into its own buffered row group
+  if (multithreaded && table.num_rows() > 0) {
+    chunk_size = std::max<int64_t>(chunk_size, 1);
+    for (int64_t offset = 0; offset < table.num_rows(); offset += chunk_size) {
+      PARQUET_THROW_NOT_OK(writer->NewBufferedRowGroup());
+      arrow::TableBatchReader batch_reader(*table.Slice(offset, chunk_size));
+      std::shared_ptr<arrow::RecordBatch> batch;
+      PARQUET_THROW_NOT_OK(batch_reader.ReadNext(&batch));
+      while (batch) {
+        PARQUET_THROW_NOT_OK(writer->WriteRecordBatch(*batch));
+        PARQUET_THROW_NOT_OK(batch_reader.ReadNext(&batch));
+      }
+    }
+    return;
+  }
+#endif
+
+  PARQUET_THROW_NOT_OK(writer->WriteTable(table, chunk_size));
+}
+
+std::shared_ptr<parquet::FileMetaData> GetParquetMetadata(const std::string& path)
+{
+  FileStat stat;
+  auto infile = OpenInputFile(path, false, stat);
+  MetadataCache::Entry entry;
+  if (stat.valid() && GetMetadataCache().Find(path, stat, entry))
+    return entry.metadata;
+
+  auto parquet_reader = parquet::ParquetFileReader::Open(infile);
+  entry.stat = stat;
+  entry.metadata = parquet_reader->metadata();
+  if (stat.valid())
+    GetMetadataCache().Insert(path, entry);
+
+  return entry.metadata;
+}
+
+std::shared_ptr<arrow::Schema> GetParquetSchema(const std::string& path)
+{
+  FileStat stat;
+  auto infile = OpenInputFile(path, false, stat);
+  MetadataCache::Entry entry;
+  if (stat.valid() && GetMetadataCache().Find(path, stat, entry) && entry.schema)
+    return entry.schema;
+
+  if (!entry.metadata) {
+    auto parquet_reader = parquet::ParquetFileReader::Open(infile);
+    entry.stat = stat;
+    entry.metadata = parquet_reader->metadata();
+  }
+
+  // Same conversion as parquet::arrow::FileReader::GetSchema with the default
+  // reader properties
+  PARQUET_THROW_NOT_OK(parquet::arrow::FromParquetSchema(
+    entry.metadata->schema(),
+    parquet::default_arrow_reader_properties(),
+    entry.metadata->key_value_metadata(),
+    &entry.schema));
+  if (stat.valid())
+    GetMetadataCache().Insert(path, entry);
+
+  return entry.schema;
+}
+
+std::vector<int> GetParquetColumnIndices(parquet::arrow::FileReader* reader, const std::vector<std::string>& names)
+{
+  std::shared_ptr<arrow::Schema> schema;
+  PARQUET_THROW_NOT_OK(reader->GetSchema(&schema));
+
+  std::vector<int> result;
+  const auto& manifest = reader->manifest();
+  for (auto index : GetFieldIndices(schema, names))
+    GetLeafColumns(manifest.schema_fields[index], result);
+
+  return result;
+}
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+K clearParquetMetadataCache(K unused)
+{
+  KDB_EXCEPTION_TRY;
+
+  kx::arrowkdb::GetMetadataCache().Clear();
+
+  return (K)0;
+
+  KDB_EXCEPTION_CATCH;
+}
@@ -0,0 +1,177 @@
+#ifndef __PARQUET_FILE_H__
+#define __PARQUET_FILE_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/util/thread_pool.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/metadata.h>
+
+#include "ArrowKdb.h"
+#include "KdbOptions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+/**
+ * @brief Opens a parquet file reader.  The parsed file footer is taken from the
+ * process wide metadata cache if the opened file's inode, modification and
+ * change times and size are unchanged since it was cached, otherwise the
+ * footer is parsed and cached.
+ *
+ * Supported options:
+ *
+ * USE_MMAP (long) - Flag indicating whether the parquet file should be memory
+ * mapped in.  Default 0
+ *
+ * PARQUET_MULTITHREADED_READ (long) - Flag indicating whether the parquet
+ * reader should run in multithreaded mode.  Default 0
+ *
+ * PARQUET_PRE_BUFFER (long) - Flag indicating whether to issue the reads for
+ * all the selected column chunks of a row group up front, coalescing nearby
+ * reads.  Default is the libarrow default
+ *
+ * PARQUET_CACHE_HOLE_SIZE_LIMIT (long) - When pre-buffering, the largest gap
+ * in bytes between two reads for them to be coalesced into one.  Default is
+ * the libarrow default
+ *
+ * PARQUET_CACHE_RANGE_SIZE_LIMIT (long) - When pre-buffering, the largest
+ * size in bytes of a coalesced read.  Default is the libarrow default
+ *
+ * PARQUET_BUFFERED_STREAM (long) - Flag indicating whether to read each column
+ * chunk through a buffered stream of PARQUET_BUFFER_SIZE bytes rather than
+ * reading it in its entirety.  Default 0
+ *
+ * PARQUET_BUFFER_SIZE (long) - Size in bytes of the buffered stream.  Default
+ * is the libarrow default
+ *
+ * PARQUET_BATCH_SIZE (long) - Number of rows decoded at a time and the size
+ * of the record batches returned by the streaming reader.  Default is the
+ * libarrow default
+ *
+ * STRINGS_AS_SYMBOLS (long) - Flag indicating whether top level string columns
+ * should be read as dictionary arrays, which are then converted to symbols.
+ * Default 0
+ *
+ * @param path    Name of the parquet file to open
+ * @param options Parsed kdb options
+ * @return        Parquet file reader
+*/
+std::unique_ptr<parquet::arrow::FileReader> OpenParquetFile(const std::string& path, const KdbOptions& options);
+
+/**
+ * @brief Returns the parsed footer of a parquet file, using the metadata cache
+ *
+ * @param path  Name of the parquet file
+ * @return      Parquet file metadata
+*/
+std::shared_ptr<parquet::FileMetaData> GetParquetMetadata(const std::string& path);
+
+/**
+ * @brief Returns the arrow schema of a parquet file, using the metadata cache.
+ * The file is always opened and stat'd to validate the cache entry, but on a
+ * hit the footer isn't read or parsed and the schema isn't converted again.
+ *
+ * @param path  Name of the parquet file
+ * @return      Arrow schema
+*/
+std::shared_ptr<arrow::Schema> GetParquetSchema(const std::string& path);
+
+/**
+ * @brief Creates a parquet file and opens a writer for it, to which tables
+ * are then written as one or more row groups.  The writer must be closed to
+ * write the file footer.
+ *
+ * Supported options:
+ *
+ * PARQUET_VERSION (string) - Select the parquet format version: `V1.0`,
+ * `V2.0`, `V2.4`, `V2.6` or `V2.LATEST`.  Versions before V2.6 coerce
+ * timestamp(ns) to timestamp(us).  Default V1.0
+ *
+ * COMPRESSION (string) - Compression codec for the column chunks.  Default
+ * UNCOMPRESSED
+ *
+ * PARQUET_DATA_PAGE_SIZE (long) - Target size in bytes of each data page.
+ * Default is the libarrow default
+ *
+ * PARQUET_WRITE_PAGE_INDEX (long) - Flag indicating whether to write the page
+ * index.  Requires libarrow 12 or later.  Default 0
+ *
+ * PARQUET_BLOOM_FILTER_COLUMNS (symbol list) - Fields to write bloom filters
+ * for, with PARQUET_BLOOM_FILTER_NDV the expected number of distinct values
+ * in each column chunk.  Requires libarrow 21 or later
+ *
+ * PARQUET_COMPRESSION_LEVEL, PARQUET_DICTIONARY_PAGE_SIZE_LIMIT,
+ * PARQUET_MAX_ROW_GROUP_LENGTH (long) - File wide compression level,
+ * dictionary page size limit and maximum row group length.  Default is the
+ * libarrow default
+ *
+ * PARQUET_COLUMN_OPTIONS (dict) - Per field COMPRESSION, COMPRESSION_LEVEL,
+ * DICTIONARY and ENCODING settings, keyed by top level field name (applied to
+ * all of its leaf columns) or by dotted leaf column path
+ *
+ * PARQUET_MULTITHREADED_WRITE (long) - Flag indicating whether to encode and
+ * compress the column chunks of a row group in parallel, for use with
+ * WriteParquetTable.  Requires libarrow 11 or later, otherwise ignored.
+ * Default 0
+ *
+ * PARQUET_WRITE_THREADS (long) - Number of threads in a pool created for
+ * this writer to encode the column chunks with PARQUET_MULTITHREADED_WRITE,
+ * capped at the number of cores.  Requires libarrow 11 or later.  Default is
+ * to use the arrow CPU thread pool
+ *
+ * @param path        Name of the parquet file to create
+ * @param schema      Arrow schema of the data to be written
+ * @param options     Parsed kdb options
+ * @param thread_pool Set to the writer's own thread pool when
+ * PARQUET_WRITE_THREADS is given, which must outlive the writer
+ * @return            Parquet file writer
+*/
+std::unique_ptr<parquet::arrow::FileWriter> OpenParquetWriter(const std::string& path, std::shared_ptr<arrow::Schema> schema, const KdbOptions& options, std::shared_ptr<arrow::internal::ThreadPool>& thread_pool);
+
+/**
+ * @brief Writes a table to a parquet writer, starting a new row group every
+ * chunk_size rows.  When multithreaded, each row group is buffered and its
+ * column chunks encoded in parallel by the writer's executor, then flushed to
+ * the file in column order so the file layout is unchanged.  Requires
+ * libarrow 11 or later, otherwise the column chunks are encoded in turn.
+ *
+ * @param writer        Parquet file writer from OpenParquetWriter
+ * @param table         Table to write
+ * @param chunk_size    Maximum number of rows in each row group
+ * @param multithreaded Encode the column chunks in parallel
+*/
+void WriteParquetTable(parquet::arrow::FileWriter* writer, const arrow::Table& table, int64_t chunk_size, bool multithreaded);
+
+/**
+ * @brief Resolves the field names selected by the COLUMNS option to the parquet
+ * leaf column indices which make up those fields.  Nested fields are made up
+ * of several leaf columns.
+ *
+ * @param reader  Parquet file reader
+ * @param names   Top level field names
+ * @return        Leaf column indices, in the order of the fields requested
+*/
+std::vector<int> GetParquetColumnIndices(parquet::arrow::FileReader* reader, const std::vector<std::string>& names);
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+extern "C"
+{
+  /**
+   * @brief Empties the process wide cache of parquet file footers and schemas
+   *
+   * @param unused
+   * @return NULL
+  */
+  EXP K clearParquetMetadataCache(K unused);
+}
+
+#endif // __PARQUET_FILE_H__
@@ -0,0 +1,657 @@
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+#include <parquet/types.h>
+#include <arrow/table.h>
+#include <arrow/util/config.h>
+#include <arrow/util/decimal.h>
+
+#if ARROW_VERSION_MAJOR >= 12
+#include <parquet/bloom_filter.h>
+#include <parquet/bloom_filter_reader.h>
+#include <parquet/page_index.h>
+#endif
+
+#include "ParquetFilter.h"
+#include "HelperFunctions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+namespace {
+
+using Options::FilterValue;
+using Options::FilterOperator;
+using Options::FilterPredicate;
+
+const static int64_t day_as_ms = 86400000LL;
+const static int64_t day_as_ns = 86400000000000LL;
+const static int64_t ms_as_ns = 1000000LL;
+
+// Maps a parquet temporal logical type to the arrow datatype which the parquet
+// reader uses for it, so that TemporalConversion can be applied to the physical
+// values.  Returns null for non-temporal logical types.
+std::shared_ptr<arrow::DataType> GetTemporalType(const std::shared_ptr<const parquet::LogicalType>& logical_type)
+{
+  auto to_time_unit = [](parquet::LogicalType::TimeUnit::unit unit) {
+    switch (unit) {
+    case parquet::LogicalType::TimeUnit::MILLIS:
+      return arrow::TimeUnit::MILLI;
+    case parquet::LogicalType::TimeUnit::MICROS:
+      return arrow::TimeUnit::MICRO;
+    default:
+      return arrow::TimeUnit::NANO;
+    }
+  };
+
+  if (logical_type->is_date())
+    return arrow::date32();
+  if (logical_type->is_timestamp())
+    return arrow::timestamp(to_time_unit(static_cast<const parquet::TimestampLogicalType&>(*logical_type).time_unit()));
+  if (logical_type->is_time()) {
+    auto time_unit = to_time_unit(static_cast<const parquet::TimeLogicalType&>(*logical_type).time_unit());
+    if (time_unit == arrow::TimeUnit::MILLI)
+      return arrow::time32(time_unit);
+    else
+      return arrow::time64(time_unit);
+  }
+
+  return nullptr;
+}
+
+// Converts an integer physical value to the kdb representation of the arrow
+// field it is read into
+FilterValue IntegerToFilterValue(int64_t value, const parquet::ColumnDescriptor* descr, const std::shared_ptr<arrow::DataType>& datatype)
+{
+  const auto& logical_type = descr->logical_type();
+  if (logical_type->is_decimal()) {
+    auto scale = static_cast<const parquet::DecimalLogicalType&>(*logical_type).scale();
+    return { FilterValue::REAL, 0, 0, static_cast<double>(value) / std::pow(10.0, scale), "" };
+  }
+
+  auto temporal_type = GetTemporalType(logical_type);
+  if (temporal_type) {
+    // date64 is stored as a parquet date (days) but read as a kdb timestamp
+    if (temporal_type->id() == arrow::Type::DATE32 && datatype->id() == arrow::Type::DATE64) {
+      temporal_type = datatype;
+      value *= day_as_ms;
+    }
+    TemporalConversion tc(temporal_type);
+    value = tc.ArrowToKdb(value);
+  } else if (datatype->id() == arrow::Type::DURATION) {
+    // Parquet has no duration logical type, the arrow schema stored in the
+    // file gives its TimeUnit
+    TemporalConversion tc(datatype);
+    value = tc.ArrowToKdb(value);
+  } else if (datatype->id() == arrow::Type::UINT16) {
+    // Unsigned columns are read into signed kdb types of the same width
+    value = static_cast<int16_t>(value);
+  } else if (datatype->id() == arrow::Type::UINT32) {
+    value = static_cast<int32_t>(value);
+  }
+
+  return { FilterValue::INTEGER, 0, value, 0, "" };
+}
+
+// Converts a byte array physical value to a filter value
+FilterValue BytesToFilterValue(const uint8_t* ptr, uint32_t len, const parquet::ColumnDescriptor* descr)
+{
+  const auto& logical_type = descr->logical_type();
+  if (logical_type->is_decimal()) {
+    auto scale = static_cast<const parquet::DecimalLogicalType&>(*logical_type).scale();
+    auto decimal = arrow::Decimal128::FromBigEndian(ptr, static_cast<int32_t>(len));
+    if (decimal.ok())
+      return { FilterValue::REAL, 0, 0, decimal.ValueOrDie().ToDouble(scale), "" };
+  }
+
+  return { FilterValue::STRING, 0, 0, 0, std::string(reinterpret_cast<const char*>(ptr), len) };
+}
+
+} // namespace
+
+bool GetMinMax(const parquet::Statistics& stats, const std::shared_ptr<arrow::DataType>& datatype, FilterValue& min, FilterValue& max)
+{
+  if (!stats.HasMinMax())
+    return false;
+
+  const auto descr = stats.descr();
+  switch (descr->physical_type()) {
+  case parquet::Type::BOOLEAN:
+  {
+    const auto& typed = static_cast<const parquet::BoolStatistics&>(stats);
+    min = { FilterValue::INTEGER, 0, typed.min(), 0, "" };
+    max = { FilterValue::INTEGER, 0, typed.max(), 0, "" };
+    break;
+  }
+  case parquet::Type::INT32:
+  {
+    const auto& typed = static_cast<const parquet::Int32Statistics&>(stats);
+    min = IntegerToFilterValue(typed.min(), descr, datatype);
+    max = IntegerToFilterValue(typed.max(), descr, datatype);
+    break;
+  }
+  case parquet::Type::INT64:
+  {
+    const auto& typed = static_cast<const parquet::Int64Statistics&>(stats);
+    min = IntegerToFilterValue(typed.min(), descr, datatype);
+    max = IntegerToFilterValue(typed.max(), descr, datatype);
+    break;
+  }
+  case parquet::Type::FLOAT:
+  {
+    const auto& typed = static_cast<const parquet::FloatStatistics&>(stats);
+    min = { FilterValue::REAL, 0, 0, typed.min(), "" };
+    max = { FilterValue::REAL, 0, 0, typed.max(), "" };
+    break;
+  }
+  case parquet::Type::DOUBLE:
+  {
+    const auto& typed = static_cast<const parquet::DoubleStatistics&>(stats);
+    min = { FilterValue::REAL, 0, 0, typed.min(), "" };
+    max = { FilterValue::REAL, 0, 0, typed.max(), "" };
+    break;
+  }
+  case parquet::Type::BYTE_ARRAY:
+  {
+    const auto& typed = static_cast<const parquet::ByteArrayStatistics&>(stats);
+    min = BytesToFilterValue(typed.min().ptr, typed.min().len, descr);
+    max = BytesToFilterValue(typed.max().ptr, typed.max().len, descr);
+    break;
+  }
+  case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+  {
+    const auto& typed = static_cast<const parquet::FLBAStatistics&>(stats);
+    min = BytesToFilterValue(typed.min().ptr, descr->type_length(), descr);
+    max = BytesToFilterValue(typed.max().ptr, descr->type_length(), descr);
+    break;
+  }
+  default:
+    // INT96 timestamps have no meaningful statistics
+    return false;
+  }
+
+  return true;
+}
+
+namespace {
+
+// Three-way comparison of two filter values.  Integers and reals are compared
+// numerically, strings bytewise.  Returns false if the values can't be
+// compared.
+bool Compare(const FilterValue& lhs, const FilterValue& rhs, int& result)
+{
+  if (lhs.kind == FilterValue::STRING || rhs.kind == FilterValue::STRING) {
+    if (lhs.kind != rhs.kind)
+      return false;
+    auto cmp = lhs.string.compare(rhs.string);
+    result = cmp < 0 ? -1 : cmp > 0 ? 1 : 0;
+  } else if (lhs.kind == FilterValue::INTEGER && rhs.kind == FilterValue::INTEGER) {
+    result = lhs.integer < rhs.integer ? -1 : lhs.integer > rhs.integer ? 1 : 0;
+  } else {
+    double l = lhs.kind == FilterValue::REAL ? lhs.real : static_cast<double>(lhs.integer);
+    double r = rhs.kind == FilterValue::REAL ? rhs.real : static_cast<double>(rhs.integer);
+    if (std::isnan(l) || std::isnan(r))
+      return false;
+    result = l < r ? -1 : l > r ? 1 : 0;
+  }
+
+  return true;
+}
+
+// Checks that min/max decoded from statistics can bound the column's values.
+// Unsigned columns are read into signed kdb types of the same width but their
+// statistics use unsigned order, so if the range crosses the sign bit the kdb
+// values aren't bounded by min/max.  (uint8 is read into unsigned kdb bytes.)
+bool IsOrdered(const FilterValue& min, const FilterValue& max, const std::shared_ptr<arrow::DataType>& datatype)
+{
+  switch (datatype->id()) {
+  case arrow::Type::UINT16:
+  case arrow::Type::UINT32:
+  case arrow::Type::UINT64:
+    if ((min.integer < 0) != (max.integer < 0))
+      return false;
+    break;
+  default:
+    break;
+  }
+
+  int cmp = 0;
+  return Compare(min, max, cmp) && cmp <= 0;
+}
+
+// Returns true if a column chunk whose values lie within [min, max] may contain
+// a value satisfying the predicate.  Values which can't be compared are always
+// treated as a potential match.
+bool MayMatch(const FilterPredicate& predicate, const FilterValue& min, const FilterValue& max)
+{
+  int cmp = 0;
+  auto in_range = [&](const FilterValue& value) {
+    int lower = 0;
+    int upper = 0;
+    if (!Compare(value, min, lower) || !Compare(value, max, upper))
+      return true;
+    return lower >= 0 && upper <= 0;
+  };
+
+  const auto& values = predicate.values;
+  switch (predicate.op) {
+  case FilterOperator::EQUAL:
+    return in_range(values[0]);
+  case FilterOperator::LESS:
+    return !Compare(min, values[0], cmp) || cmp < 0;
+  case FilterOperator::LESS_EQUAL:
+    return !Compare(min, values[0], cmp) || cmp <= 0;
+  case FilterOperator::GREATER:
+    return !Compare(max, values[0], cmp) || cmp > 0;
+  case FilterOperator::GREATER_EQUAL:
+    return !Compare(max, values[0], cmp) || cmp >= 0;
+  case FilterOperator::WITHIN:
+  {
+    bool above_lower = !Compare(max, values[0], cmp) || cmp >= 0;
+    bool below_upper = !Compare(min, values[1], cmp) || cmp <= 0;
+    return above_lower && below_upper;
+  }
+  case FilterOperator::IN:
+    for (const auto& value : values)
+      if (in_range(value))
+        return true;
+    return false;
+  }
+
+  return true;
+}
+
+#if ARROW_VERSION_MAJOR >= 12
+// Hashes a filter value as the physical value that the column chunk stores,
+// undoing the conversions applied when reading it into kdb.  Returns false if
+// the value can't be represented, in which case the bloom filter can't be
+// used.
+bool HashFilterValue(const parquet::BloomFilter& bloom_filter, const FilterValue& value, const parquet::ColumnDescriptor* descr, const std::shared_ptr<arrow::DataType>& datatype, uint64_t& hash)
+{
+  const auto& logical_type = descr->logical_type();
+  if (logical_type->is_decimal())
+    return false;
+
+  switch (descr->physical_type()) {
+  case parquet::Type::INT32:
+  case parquet::Type::INT64:
+  {
+    if (value.kind != FilterValue::INTEGER)
+      return false;
+
+    int64_t physical = value.integer;
+    auto temporal_type = GetTemporalType(logical_type);
+    if (temporal_type) {
+      // date64 is stored as a parquet date (days) but read as a kdb timestamp
+      if (temporal_type->id() == arrow::Type::DATE32 && datatype->id() == arrow::Type::DATE64)
+        return false;
+      TemporalConversion tc(temporal_type);
+      physical = tc.KdbToArrow(physical);
+    } else if (logical_type->is_int()) {
+      // Unsigned columns are read into signed kdb types of the same width
+      const auto& int_type = static_cast<const parquet::IntLogicalType&>(*logical_type);
+      if (!int_type.is_signed() && int_type.bit_width() < 64)
+        physical &= (1LL << int_type.bit_width()) - 1;
+    }
+
+    if (descr->physical_type() == parquet::Type::INT32)
+      hash = bloom_filter.Hash(static_cast<int32_t>(physical));
+    else
+      hash = bloom_filter.Hash(physical);
+    break;
+  }
+  case parquet::Type::FLOAT:
+  case parquet::Type::DOUBLE:
+  {
+    if (value.kind == FilterValue::STRING)
+      return false;
+
+    // Bloom filters hash the bit pattern, which differs for -0.0 and 0.0
+    double real = value.kind == FilterValue::REAL ? value.real : static_cast<double>(value.integer);
+    if (real == 0 || std::isnan(real))
+      return false;
+
+    if (descr->physical_type() == parquet::Type::FLOAT)
+      hash = bloom_filter.Hash(static_cast<float>(real));
+    else
+      hash = bloom_filter.Hash(real);
+    break;
+  }
+  case parquet::Type::BYTE_ARRAY:
+  {
+    if (value.kind != FilterValue::STRING)
+      return false;
+
+    parquet::ByteArray byte_array(static_cast<uint32_t>(value.string.length()), reinterpret_cast<const uint8_t*>(value.string.data()));
+    hash = bloom_filter.Hash(&byte_array);
+    break;
+  }
+  case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+  {
+    if (value.kind != FilterValue::STRING || value.string.length() != static_cast<size_t>(descr->type_length()))
+      return false;
+
+    parquet::FixedLenByteArray fixed_len_byte_array(reinterpret_cast<const uint8_t*>(value.string.data()));
+    hash = bloom_filter.Hash(&fixed_len_byte_array, descr->type_length());
+    break;
+  }
+  default:
+    // Boolean and INT96 columns don't have bloom filters
+    return false;
+  }
+
+  return true;
+}
+
+// Uses a column chunk's bloom filter to check whether it may contain any of
+// the values of an equality or in predicate.  Column chunks without a bloom
+// filter, or values which can't be hashed, are always treated as a potential
+// match.
+bool BloomFilterMayMatch(parquet::BloomFilterReader& bloom_filter_reader, int row_group, int column, const FilterPredicate& predicate, const std::shared_ptr<arrow::DataType>& datatype, const parquet::ColumnDescriptor* descr)
+{
+  const auto bloom_filter = bloom_filter_reader.RowGroup(row_group)->GetColumnBloomFilter(column);
+  if (!bloom_filter)
+    return true;
+
+  for (const auto& value : predicate.values) {
+    uint64_t hash = 0;
+    if (!HashFilterValue(*bloom_filter, value, descr, datatype, hash) || bloom_filter->FindHash(hash))
+      return true;
+  }
+
+  return false;
+}
+#endif
+
+#if ARROW_VERSION_MAJOR >= 12
+RowRanges IntersectRanges(const RowRanges& lhs, const RowRanges& rhs)
+{
+  RowRanges result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < lhs.size() && j < rhs.size()) {
+    auto start = std::max(lhs[i].first, rhs[j].first);
+    auto end = std::min(lhs[i].second, rhs[j].second);
+    if (start < end)
+      result.push_back({ start, end });
+    if (lhs[i].second < rhs[j].second)
+      ++i;
+    else
+      ++j;
+  }
+
+  return result;
+}
+
+// Uses a column chunk's column index and offset index to find the rows of the
+// data pages which may satisfy the predicate.  Pages without usable min/max
+// values are always treated as a potential match.
+RowRanges PageRowRanges(const parquet::ColumnIndex& column_index, const parquet::OffsetIndex& offset_index, const parquet::ColumnDescriptor* descr, int64_t num_rows, const FilterPredicate& predicate, const std::shared_ptr<arrow::DataType>& datatype)
+{
+  const auto& page_locations = offset_index.page_locations();
+  const auto& null_pages = column_index.null_pages();
+  const auto& encoded_min = column_index.encoded_min_values();
+  const auto& encoded_max = column_index.encoded_max_values();
+
+  RowRanges result;
+  for (size_t page = 0; page < page_locations.size(); ++page) {
+    auto start = page_locations[page].first_row_index;
+    auto end = page + 1 < page_locations.size() ? page_locations[page + 1].first_row_index : num_rows;
+
+    bool may_match = true;
+    if (page < null_pages.size() && !null_pages[page] && page < encoded_min.size() && page < encoded_max.size()) {
+      // Decode the page's min/max the same way as the column chunk statistics
+      auto stats = parquet::Statistics::Make(descr, encoded_min[page], encoded_max[page], end - start, 0, 0, true, false, false);
+      FilterValue min;
+      FilterValue max;
+      if (stats && GetMinMax(*stats, datatype, min, max) && IsOrdered(min, max, datatype))
+        may_match = MayMatch(predicate, min, max);
+    }
+
+    if (!may_match)
+      continue;
+    if (!result.empty() && result.back().second == start)
+      result.back().second = end;
+    else
+      result.push_back({ start, end });
+  }
+
+  return result;
+}
+
+// Intersects the matching page rows of each predicate's column within a row
+// group.  Row groups or columns without a page index match all their rows.
+RowRanges MatchingPageRows(parquet::PageIndexReader& page_index_reader, const parquet::FileMetaData& metadata, int row_group, const std::vector<FilterPredicate>& predicates, const std::vector<int>& columns, const std::vector<std::shared_ptr<arrow::DataType>>& datatypes)
+{
+  const auto num_rows = metadata.RowGroup(row_group)->num_rows();
+  RowRanges ranges{ { 0, num_rows } };
+
+  const auto row_group_page_index = page_index_reader.RowGroup(row_group);
+  for (size_t i = 0; row_group_page_index && !ranges.empty() && i < predicates.size(); ++i) {
+    if (columns[i] < 0)
+      continue;
+
+    const auto column_index = row_group_page_index->GetColumnIndex(columns[i]);
+    const auto offset_index = row_group_page_index->GetOffsetIndex(columns[i]);
+    if (!column_index || !offset_index)
+      continue;
+
+    ranges = IntersectRanges(ranges, PageRowRanges(*column_index, *offset_index, metadata.schema()->Column(columns[i]), num_rows, predicates[i], datatypes[i]));
+  }
+
+  return ranges;
+}
+#endif
+
+// Finds the parquet leaf column index and arrow field for a top level field.
+// Nested fields have no single leaf column so return -1.
+int FindColumn(const parquet::arrow::SchemaManifest& manifest, const std::string& name, std::shared_ptr<arrow::DataType>& datatype)
+{
+  for (const auto& schema_field : manifest.schema_fields) {
+    if (schema_field.field->name() == name) {
+      datatype = schema_field.field->type();
+      return schema_field.column_index;
+    }
+  }
+
+  throw KdbOptions::InvalidOption("FILTER column '" + name + "' not found");
+}
+
+// Checks a filter value against the kdb type of the field it is compared
+// with, since the statistics are decoded into that type.  A date is converted
+// for comparison with a timestamp column and a time with a time64 column,
+// other temporal values of a different type can't be compared so are
+// rejected.
+FilterValue TypeFilterValue(const FilterValue& value, const std::string& column, const std::shared_ptr<arrow::DataType>& datatype)
+{
+  auto value_type = datatype;
+  if (datatype->id() == arrow::Type::DICTIONARY)
+    value_type = static_cast<const arrow::DictionaryType&>(*datatype).value_type();
+
+  TypeMappingOverride type_overrides;
+  const auto field_type = GetKdbType(value_type, type_overrides);
+  auto is_temporal = [](int kdb_type) {
+    return kdb_type == KP || kdb_type == KM || kdb_type == KD || kdb_type == KN || kdb_type == KT;
+  };
+  auto mismatch = [&]() {
+    return KdbOptions::InvalidOption("FILTER value for column '" + column + "' has type " + std::to_string(value.kdb_type) + "h but the column is read as " + std::to_string(field_type) + "h");
+  };
+
+  if (is_temporal(field_type) || (value.kind == FilterValue::INTEGER && is_temporal(-value.kdb_type))) {
+    if (value.kind != FilterValue::INTEGER)
+      throw mismatch();
+    if (-value.kdb_type == field_type)
+      return value;
+
+    FilterValue result = value;
+    result.kdb_type = static_cast<signed char>(-field_type);
+    const bool is_null = value.integer == std::numeric_limits<int32_t>::min();
+    if (-value.kdb_type == KD && field_type == KP)
+      result.integer = is_null ? std::numeric_limits<int64_t>::min() : value.integer * day_as_ns;
+    else if (-value.kdb_type == KT && value_type->id() == arrow::Type::TIME64)
+      result.integer = is_null ? std::numeric_limits<int64_t>::min() : value.integer * ms_as_ns;
+    else
+      throw mismatch();
+    return result;
+  }
+
+  switch (value_type->id()) {
+  case arrow::Type::STRING:
+  case arrow::Type::LARGE_STRING:
+  case arrow::Type::BINARY:
+  case arrow::Type::LARGE_BINARY:
+  case arrow::Type::FIXED_SIZE_BINARY:
+    if (value.kind != FilterValue::STRING)
+      throw mismatch();
+    break;
+  default:
+    if (value.kind == FilterValue::STRING)
+      throw mismatch();
+    break;
+  }
+
+  return value;
+}
+
+// Resolves each predicate's column and checks its values against that column
+std::vector<FilterPredicate> ResolvePredicates(const parquet::arrow::SchemaManifest& manifest, const std::vector<FilterPredicate>& predicates, std::vector<int>& columns, std::vector<std::shared_ptr<arrow::DataType>>& datatypes)
+{
+  std::vector<FilterPredicate> result;
+  for (const auto& predicate : predicates) {
+    std::shared_ptr<arrow::DataType> datatype;
+    const auto column = FindColumn(manifest, predicate.column, datatype);
+    columns.push_back(column);
+    datatypes.push_back(datatype);
+
+    // Nested columns are never used to exclude rows
+    auto typed = predicate;
+    if (column >= 0)
+      for (auto& value : typed.values)
+        value = TypeFilterValue(value, predicate.column, datatype);
+    result.push_back(typed);
+  }
+
+  return result;
+}
+
+} // namespace
+
+std::vector<int> FilterRowGroups(parquet::arrow::FileReader* reader, const std::vector<FilterPredicate>& filter, const std::vector<int>& row_groups, std::vector<RowRanges>* page_rows)
+{
+  const auto metadata = reader->parquet_reader()->metadata();
+
+  // Resolve each predicate's column once
+  std::vector<int> columns;
+  std::vector<std::shared_ptr<arrow::DataType>> datatypes;
+  const auto predicates = ResolvePredicates(reader->manifest(), filter, columns, datatypes);
+
+  std::vector<int> result;
+  if (page_rows)
+    page_rows->clear();
+  for (auto row_group : row_groups) {
+    const auto row_group_metadata = metadata->RowGroup(row_group);
+    RowRanges ranges{ { 0, row_group_metadata->num_rows() } };
+    bool may_match = true;
+    for (size_t i = 0; may_match && i < predicates.size(); ++i) {
+      if (columns[i] < 0)
+        continue;
+
+      const auto column_chunk = row_group_metadata->ColumnChunk(columns[i]);
+      if (!column_chunk->is_stats_set())
+        continue;
+      const auto stats = column_chunk->statistics();
+
+      FilterValue min;
+      FilterValue max;
+      if (!stats || !GetMinMax(*stats, datatypes[i], min, max) || !IsOrdered(min, max, datatypes[i]))
+        continue;
+
+      may_match = MayMatch(predicates[i], min, max);
+    }
+
+#if ARROW_VERSION_MAJOR >= 12
+    // Statistics are of little use for point lookups on high cardinality
+    // columns so also check the bloom filters of any remaining row groups
+    for (size_t i = 0; may_match && i < predicates.size(); ++i) {
+      const auto op = predicates[i].op;
+      if (columns[i] < 0 || (op != FilterOperator::EQUAL && op != FilterOperator::IN))
+        continue;
+
+      auto& bloom_filter_reader = reader->parquet_reader()->GetBloomFilterReader();
+      may_match = BloomFilterMayMatch(bloom_filter_reader, row_group, columns[i], predicates[i], datatypes[i], metadata->schema()->Column(columns[i]));
+    }
+
+    // The page min/max values are finer grained than the column chunk
+    // statistics, and their ranges are intersected across the predicates, so
+    // may show that no row of the row group can match.  Otherwise the matching
+    // rows are kept for TrimPageRows.
+    if (may_match && !predicates.empty()) {
+      const auto page_index_reader = reader->parquet_reader()->GetPageIndexReader();
+      if (page_index_reader) {
+        ranges = MatchingPageRows(*page_index_reader, *metadata, row_group, predicates, columns, datatypes);
+        may_match = !ranges.empty();
+      }
+    }
+#endif
+
+    if (may_match) {
+      result.push_back(row_group);
+      if (page_rows)
+        page_rows->push_back(std::move(ranges));
+    }
+  }
+
+  return result;
+}
+
+std::shared_ptr<arrow::Table> TrimPageRows(parquet::arrow::FileReader* reader, const std::vector<int>& row_groups, const std::vector<RowRanges>& page_rows, std::shared_ptr<arrow::Table> table)
+{
+#if ARROW_VERSION_MAJOR >= 12
+  const auto metadata = reader->parquet_reader()->metadata();
+
+  // Offset the rows of each row group which may match by the position of that
+  // row group in the table
+  RowRanges table_ranges;
+  int64_t row_group_offset = 0;
+  for (size_t i = 0; i < row_groups.size(); ++i) {
+    const auto num_rows = metadata->RowGroup(row_groups[i])->num_rows();
+    for (const auto& range : page_rows[i]) {
+      if (!table_ranges.empty() && table_ranges.back().second == row_group_offset + range.first)
+        table_ranges.back().second = row_group_offset + range.second;
+      else
+        table_ranges.push_back({ row_group_offset + range.first, row_group_offset + range.second });
+    }
+    row_group_offset += num_rows;
+  }
+
+  if (table_ranges.size() == 1 && table_ranges[0].first == 0 && table_ranges[0].second == table->num_rows())
+    return table;
+  if (table_ranges.empty())
+    return table->Slice(0, 0);
+
+  // Slicing and concatenating only rearranges the chunks, no data is copied
+  std::vector<std::shared_ptr<arrow::Table>> slices;
+  for (const auto& range : table_ranges)
+    slices.push_back(table->Slice(range.first, range.second - range.first));
+  PARQUET_ASSIGN_OR_THROW(table, arrow::ConcatenateTables(slices));
+#endif
+
+  return table;
+}
+
+std::vector<int> FilterRowGroups(parquet::arrow::FileReader* reader, const std::vector<FilterPredicate>& predicates, std::vector<RowRanges>* page_rows)
+{
+  std::vector<int> row_groups(reader->num_row_groups());
+  std::iota(row_groups.begin(), row_groups.end(), 0);
+
+  return FilterRowGroups(reader, predicates, row_groups, page_rows);
+}
+
+} // namespace arrowkdb
+} // namespace kx
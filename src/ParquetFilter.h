@@ -0,0 +1,85 @@
+#ifndef __PARQUET_FILTER_H__
+#define __PARQUET_FILTER_H__
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <parquet/arrow/reader.h>
+#include <parquet/statistics.h>
+
+#include "KdbOptions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+// Sorted, non-overlapping [start, end) row ranges within a row group
+using RowRanges = std::vector<std::pair<int64_t, int64_t>>;
+
+/**
+ * @brief Uses the column chunk statistics held in a parquet file's metadata to
+ * determine which row groups may contain rows matching all the filter
+ * predicates.  A row group is only excluded when its statistics prove that no
+ * row within it can match, so the result is a superset of the row groups which
+ * contain matching rows.  Predicates on columns without usable statistics
+ * (nested columns, all null column chunks, etc.) never exclude a row group.
+ * Predicate values must match the kdb type each column is read into, otherwise
+ * InvalidOption is thrown.  Equality and in predicates also use the column
+ * chunk bloom filters, and all predicates the page index, where the file has
+ * them.
+ *
+ * @param reader      Parquet file reader
+ * @param predicates  Filter predicates, all of which must be satisfied
+ * @param row_groups  Candidate row group indices
+ * @param page_rows   If not null, set to the rows of each returned row group
+ * which the page index shows may match, for use with TrimPageRows.  Row
+ * groups without a page index are given all their rows.
+ * @return            Subset of row_groups which may contain matching rows
+*/
+std::vector<int> FilterRowGroups(parquet::arrow::FileReader* reader, const std::vector<Options::FilterPredicate>& predicates, const std::vector<int>& row_groups, std::vector<RowRanges>* page_rows = nullptr);
+
+/**
+ * @brief As above but considering all the row groups in the parquet file
+*/
+std::vector<int> FilterRowGroups(parquet::arrow::FileReader* reader, const std::vector<Options::FilterPredicate>& predicates, std::vector<RowRanges>* page_rows = nullptr);
+
+/**
+ * @brief Decodes the min/max values from a column chunk's statistics into the
+ * kdb representation of the arrow field they are read into.  Temporal values
+ * are converted using TemporalConversion, decimals to doubles, byte arrays
+ * to strings and unsigned integers to the signed kdb type they are read into.
+ *
+ * @param stats     Column chunk statistics
+ * @param datatype  Arrow datatype of the field the column is read into
+ * @param min       Set to the minimum value
+ * @param max       Set to the maximum value
+ * @return          False if the min/max are not available or can't be
+ * represented
+*/
+bool GetMinMax(const parquet::Statistics& stats, const std::shared_ptr<arrow::DataType>& datatype, Options::FilterValue& min, Options::FilterValue& max);
+
+/**
+ * @brief Row trimming using the page index (column index and offset index) of
+ * the row groups read into a table.  Removes the rows of any data pages whose
+ * min/max values prove they cannot match all the filter predicates.  This is
+ * not page level pushdown: parquet::arrow::FileReader has no row selection so
+ * the whole of each row group has already been read and decoded, and the rows
+ * are only removed, without copying, before conversion to kdb.  Row groups or
+ * columns without a page index are kept in full.  Requires libarrow 12 or
+ * later, otherwise the table is returned unchanged.
+ *
+ * @param reader      Parquet file reader
+ * @param row_groups  Row group indices read into the table, in order
+ * @param page_rows   Rows of each row group which may match, as returned by
+ * FilterRowGroups for row_groups
+ * @param table       Table read from row_groups
+ * @return            Table containing the rows of pages which may match
+*/
+std::shared_ptr<arrow::Table> TrimPageRows(parquet::arrow::FileReader* reader, const std::vector<int>& row_groups, const std::vector<RowRanges>& page_rows, std::shared_ptr<arrow::Table> table);
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+#endif // __PARQUET_FILTER_H__
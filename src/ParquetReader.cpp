@@ -0,0 +1,128 @@
+#include <vector>
+#include <memory>
+#include <numeric>
+
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+
+#include "ParquetReader.h"
+#include "ParquetFile.h"
+#include "ParquetFilter.h"
+#include "ArrayReader.h"
+#include "HelperFunctions.h"
+#include "KdbOptions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+template<>
+HandleStore<std::shared_ptr<ParquetBatchReader>>* HandleStore<std::shared_ptr<ParquetBatchReader>>::instance = nullptr;
+
+HandleStore<std::shared_ptr<ParquetBatchReader>>* GetParquetReaderStore()
+{
+  return HandleStore<std::shared_ptr<ParquetBatchReader>>::Instance();
+}
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+K openParquetReader(K parquet_file, K options)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (!kx::arrowkdb::IsKdbString(parquet_file))
+    return krr((S)"parquet_file not 11h or 0 of 10h");
+
+  // Parse the options
+  auto read_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
+
+  auto reader = std::make_shared<kx::arrowkdb::ParquetBatchReader>();
+
+  // Type mapping overrides
+  reader->type_overrides = kx::arrowkdb::TypeMappingOverride{ read_options };
+  read_options.GetIntOption(kx::arrowkdb::Options::WITH_NULL_BITMAP, reader->with_null_bitmap);
+
+  reader->file_reader = kx::arrowkdb::OpenParquetFile(kx::arrowkdb::GetKdbString(parquet_file), read_options);
+
+  // Row group predicate pushdown
+  std::vector<kx::arrowkdb::Options::FilterPredicate> filter;
+  read_options.GetFilterOptions(filter);
+  auto row_groups = kx::arrowkdb::FilterRowGroups(reader->file_reader.get(), filter);
+
+  // Column projection
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+  if (column_names.empty())
+    PARQUET_THROW_NOT_OK(reader->file_reader->GetRecordBatchReader(row_groups, &reader->batch_reader));
+  else
+    PARQUET_THROW_NOT_OK(reader->file_reader->GetRecordBatchReader(row_groups, kx::arrowkdb::GetParquetColumnIndices(reader->file_reader.get(), column_names), &reader->batch_reader));
+
+  const auto schema = reader->batch_reader->schema();
+  reader->column_order.resize(schema->num_fields());
+  std::iota(reader->column_order.begin(), reader->column_order.end(), 0);
+  if (!column_names.empty())
+    reader->column_order = kx::arrowkdb::GetFieldIndices(schema, column_names);
+
+  return ki(kx::arrowkdb::GetParquetReaderStore()->Add(reader));
+
+  KDB_EXCEPTION_CATCH;
+}
+
+K readNextBatch(K reader_id)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (reader_id->t != -KI)
+    return krr((S)"reader_id not -6h");
+
+  auto reader = kx::arrowkdb::GetParquetReaderStore()->Find(reader_id->i);
+  if (!reader)
+    return krr((S)"unknown reader");
+
+  // Serialise access to the reader in case it is shared between threads
+  std::lock_guard<std::mutex> lock(reader->mutex);
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  PARQUET_THROW_NOT_OK(reader->batch_reader->ReadNext(&batch));
+
+  // End of file
+  if (!batch)
+    return ktn(0, 0);
+
+  const auto& column_order = reader->column_order;
+  const auto col_num = column_order.size();
+  K data = ktn(0, col_num);
+  for (size_t i = 0; i < col_num; ++i)
+    kK(data)[i] = kx::arrowkdb::ReadArray(batch->column(column_order[i]), reader->type_overrides);
+
+  if (reader->with_null_bitmap) {
+    K bitmap = ktn(0, col_num);
+    for (size_t i = 0; i < col_num; ++i)
+      kK(bitmap)[i] = kx::arrowkdb::ReadArrayNullBitmap(batch->column(column_order[i]), reader->type_overrides);
+    K array = data;
+    data = ktn(0, 2);
+    kK(data)[0] = array;
+    kK(data)[1] = bitmap;
+  }
+
+  return data;
+
+  KDB_EXCEPTION_CATCH;
+}
+
+K closeReader(K reader_id)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (reader_id->t != -KI)
+    return krr((S)"reader_id not -6h");
+
+  if (!kx::arrowkdb::GetParquetReaderStore()->Remove(reader_id->i))
+    return krr((S)"unknown reader");
+
+  return (K)0;
+
+  KDB_EXCEPTION_CATCH;
+}
@@ -0,0 +1,114 @@
+#ifndef __PARQUET_READER_H__
+#define __PARQUET_READER_H__
+
+#include <memory>
+#include <vector>
+#include <mutex>
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+
+#include "ArrowKdb.h"
+#include "HandleStore.h"
+#include "HelperFunctions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+/**
+ * @brief State of an open streaming parquet reader.  The parquet file reader
+ * must outlive the record batch reader created from it.
+*/
+struct ParquetBatchReader
+{
+  std::unique_ptr<parquet::arrow::FileReader> file_reader;
+  std::unique_ptr<arrow::RecordBatchReader> batch_reader;
+  TypeMappingOverride type_overrides;
+  int64_t with_null_bitmap = 0;
+  std::vector<int> column_order; // batch columns in the order returned to kdb
+  std::mutex mutex;
+};
+
+/**
+ * @brief Returns the ParquetReaderStore singleton which uses the HandleStore
+ * template, specialised on std::shared_ptr<ParquetBatchReader>
+ *
+ * @return Pointer to the ParquetReaderStore singleton
+*/
+HandleStore<std::shared_ptr<ParquetBatchReader>>* GetParquetReaderStore();
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+extern "C"
+{
+  /**
+   * @brief Opens a parquet file for streaming, returning a reader handle from
+   * which the file's data can be read one record batch at a time.  This allows
+   * files larger than the available memory to be processed since only one row
+   * group is decoded at a time.
+   *
+   * Supported options:
+   *
+   * PARQUET_MULTITHREADED_READ (long) - Flag indicating whether the parquet
+   * reader should run in multithreaded mode.   This can improve performance by
+   * processing multiple columns in parallel.  Default 0
+   *
+   * USE_MMAP (long) - Flag indicating whether the parquet file should be memory
+   * mapped in.  This can improve performance on systems which support mmap.
+   * Default 0
+   *
+   * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
+   * default type mapping for the arrow decimal128 datatype and instead
+   * represent it as a double (9h).  Default 0.
+   *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * WITH_NULL_BITMAP (long) - Flag indicating whether each batch should be
+   * returned as the data values and the null bitmap.  Default 0.
+   *
+   * FILTER (list) - Predicate or list of predicates, each of the form
+   * (operator;column;value), used to skip row groups whose column chunk
+   * statistics show they cannot contain matching rows.  The batches don't
+   * follow the row group boundaries so, unlike the table readers, the rows of
+   * pages excluded by the page index aren't trimmed from them.
+   *
+   * @param parquet_file  String name of the parquet file to read
+   * @options             Dictionary of options or generic null (::) to use
+   * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
+   * mixed list of -7|-11|4|0h.
+   * @return              Reader handle (-6h)
+  */
+  EXP K openParquetReader(K parquet_file, K options);
+
+  /**
+   * @brief Reads the next record batch from a streaming parquet reader
+   *
+   * @param reader_id Reader handle returned by openParquetReader
+   * @return          Mixed list of arrow array objects for the next batch, or
+   * an empty mixed list once all batches have been read
+  */
+  EXP K readNextBatch(K reader_id);
+
+  /**
+   * @brief Closes a streaming parquet reader, releasing the file and any
+   * buffered data
+   *
+   * @param reader_id Reader handle returned by openParquetReader
+   * @return          NULL on success, error otherwise
+  */
+  EXP K closeReader(K reader_id);
+}
+
+#endif // __PARQUET_READER_H__
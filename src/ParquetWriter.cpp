@@ -0,0 +1,133 @@
+#include <memory>
+#include <algorithm>
+
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+
+#include "ParquetWriter.h"
+#include "ParquetFile.h"
+#include "ArrayWriter.h"
+#include "HelperFunctions.h"
+#include "SchemaStore.h"
+#include "KdbOptions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+template<>
+HandleStore<std::shared_ptr<ParquetBatchWriter>>* HandleStore<std::shared_ptr<ParquetBatchWriter>>::instance = nullptr;
+
+HandleStore<std::shared_ptr<ParquetBatchWriter>>* GetParquetWriterStore()
+{
+  return HandleStore<std::shared_ptr<ParquetBatchWriter>>::Instance();
+}
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+K openParquetWriter(K parquet_file, K schema_id, K options)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (!kx::arrowkdb::IsKdbString(parquet_file))
+    return krr((S)"parquet_file not 11h or 0 of 10h");
+  if (schema_id->t != -KI)
+    return krr((S)"schema_id not -6h");
+
+  const auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
+  if (!schema)
+    return krr((S)"unknown schema");
+
+  // Parse the options
+  auto write_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
+
+  auto writer = std::make_shared<kx::arrowkdb::ParquetBatchWriter>();
+  writer->schema = schema;
+
+  // Type mapping overrides
+  writer->type_overrides = kx::arrowkdb::TypeMappingOverride{ write_options };
+  write_options.GetIntOption(kx::arrowkdb::Options::ARROW_CHUNK_ROWS, writer->type_overrides.chunk_length);
+
+  int64_t multithreaded_write = 0;
+  write_options.GetIntOption(kx::arrowkdb::Options::PARQUET_MULTITHREADED_WRITE, multithreaded_write);
+  writer->multithreaded = multithreaded_write;
+
+  if (writer->type_overrides.symbols_as_dictionary) {
+    writer->path = kx::arrowkdb::GetKdbString(parquet_file);
+    writer->write_options.reset(new kx::arrowkdb::KdbOptions(write_options));
+  } else {
+    writer->file_writer = kx::arrowkdb::OpenParquetWriter(kx::arrowkdb::GetKdbString(parquet_file), schema, write_options, writer->thread_pool);
+  }
+
+  return ki(kx::arrowkdb::GetParquetWriterStore()->Add(writer));
+
+  KDB_EXCEPTION_CATCH;
+}
+
+K writeRowGroup(K writer_id, K array_data)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (writer_id->t != -KI)
+    return krr((S)"writer_id not -6h");
+
+  auto writer = kx::arrowkdb::GetParquetWriterStore()->Find(writer_id->i);
+  if (!writer)
+    return krr((S)"unknown writer");
+
+  // Serialise access to the writer in case it is shared between threads
+  std::lock_guard<std::mutex> lock(writer->mutex);
+
+  // The first row group decides which symbol fields are dictionary encoded
+  if (!writer->file_writer) {
+    writer->schema = kx::arrowkdb::ApplySymbolsAsDictionary(writer->schema, array_data, writer->type_overrides);
+    writer->file_writer = kx::arrowkdb::OpenParquetWriter(writer->path, writer->schema, *writer->write_options, writer->thread_pool);
+  } else if (writer->type_overrides.symbols_as_dictionary) {
+    kx::arrowkdb::CheckSymbolsAsDictionary(writer->schema, array_data, writer->row_groups);
+  }
+
+  // Only this batch is held as an arrow table
+  auto chunked_arrays = kx::arrowkdb::MakeChunkedArrays(writer->schema, array_data, writer->type_overrides, writer->multithreaded);
+  auto table = arrow::Table::Make(writer->schema, chunked_arrays);
+
+  // Write the whole batch as one row group
+  kx::arrowkdb::WriteParquetTable(writer->file_writer.get(), *table, std::max<int64_t>(table->num_rows(), 1), writer->multithreaded);
+  ++writer->row_groups;
+
+  // Release any zero copy kdb lists whose buffers were freed by arrow's threads
+  table.reset();
+  chunked_arrays.clear();
+  kx::arrowkdb::ReleaseKdbBuffers();
+
+  return (K)0;
+
+  KDB_EXCEPTION_CATCH;
+}
+
+K closeWriter(K writer_id)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (writer_id->t != -KI)
+    return krr((S)"writer_id not -6h");
+
+  auto writer = kx::arrowkdb::GetParquetWriterStore()->Remove(writer_id->i);
+  if (!writer)
+    return krr((S)"unknown writer");
+
+  std::lock_guard<std::mutex> lock(writer->mutex);
+  if (!writer->file_writer)
+    writer->file_writer = kx::arrowkdb::OpenParquetWriter(writer->path, writer->schema, *writer->write_options, writer->thread_pool);
+  PARQUET_THROW_NOT_OK(writer->file_writer->Close());
+
+  // Join the writer's own encoding threads, if any
+  writer->file_writer.reset();
+  writer->thread_pool.reset();
+  kx::arrowkdb::ReleaseKdbBuffers();
+
+  return (K)0;
+
+  KDB_EXCEPTION_CATCH;
+}
@@ -0,0 +1,143 @@
+#ifndef __PARQUET_WRITER_H__
+#define __PARQUET_WRITER_H__
+
+#include <memory>
+#include <mutex>
+
+#include <arrow/api.h>
+#include <arrow/util/thread_pool.h>
+#include <parquet/arrow/writer.h>
+
+#include "ArrowKdb.h"
+#include "HandleStore.h"
+#include "HelperFunctions.h"
+#include "KdbOptions.h"
+
+
+namespace kx {
+namespace arrowkdb {
+
+/**
+ * @brief State of an open incremental parquet writer
+*/
+struct ParquetBatchWriter
+{
+  // Declared first so that it is destroyed after the file writer using it
+  std::shared_ptr<arrow::internal::ThreadPool> thread_pool;
+  std::unique_ptr<parquet::arrow::FileWriter> file_writer;
+  std::shared_ptr<arrow::Schema> schema;
+  // With SYMBOLS_AS_DICTIONARY the file is only opened by the first row group,
+  // whose symbol lists determine the dictionary fields
+  std::string path;
+  std::unique_ptr<KdbOptions> write_options;
+  TypeMappingOverride type_overrides;
+  bool multithreaded = false;
+  int64_t row_groups = 0;
+  std::mutex mutex;
+};
+
+/**
+ * @brief Returns the ParquetWriterStore singleton which uses the HandleStore
+ * template, specialised on std::shared_ptr<ParquetBatchWriter>
+ *
+ * @return Pointer to the ParquetWriterStore singleton
+*/
+HandleStore<std::shared_ptr<ParquetBatchWriter>>* GetParquetWriterStore();
+
+} // namespace arrowkdb
+} // namespace kx
+
+
+extern "C"
+{
+  /**
+   * @brief Creates a parquet file for incremental writing, returning a writer
+   * handle to which the data can be appended one row group at a time.  This
+   * allows files larger than the available memory to be written since only
+   * the current batch is held as both kdb and arrow data.
+   *
+   * Supported options:
+   *
+   * PARQUET_VERSION (string) - Select the parquet format version, either
+   * `V1.0`, `V2.0`, `V2.4`, `V2.6` or `V2.LATEST`.  Later versions are more
+   * fully featured but may be incompatible with older parquet implementations.
+   * Default `V1.0`
+   *
+   * COMPRESSION (string) - Selects the compression type for the column
+   * chunks.  Default `UNCOMPRESSED`
+   *
+   * PARQUET_DATA_PAGE_SIZE (long) - Target size in bytes of each data page.
+   * Default is the libarrow default
+   *
+   * PARQUET_WRITE_PAGE_INDEX (long) - Flag indicating whether to write the
+   * page index.  Default 0
+   *
+   * PARQUET_BLOOM_FILTER_COLUMNS (symbol list) and PARQUET_BLOOM_FILTER_NDV
+   * (long) - Fields to write bloom filters for and the expected number of
+   * distinct values in each column chunk
+   *
+   * PARQUET_COMPRESSION_LEVEL, PARQUET_DICTIONARY_PAGE_SIZE_LIMIT,
+   * PARQUET_MAX_ROW_GROUP_LENGTH (long) and PARQUET_COLUMN_OPTIONS (dict) -
+   * File wide and per field encoding and compression settings, as for
+   * writeParquet
+   *
+   * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
+   * default type mapping for the arrow decimal128 datatype and instead
+   * represent it as a double (9h).  Default 0.
+   *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * ARROW_CHUNK_ROWS (long) - Number of rows in each arrow array chunk created
+   * from the kdb data of a row group.  Default 0 (one chunk)
+   *
+   * PARQUET_MULTITHREADED_WRITE (long) - Flag indicating whether to build the
+   * arrow arrays of each row group and encode its column chunks in parallel.
+   * Parallel encoding requires libarrow 11 or later.  Default 0
+   *
+   * PARQUET_WRITE_THREADS (long) - Number of threads used to encode the column
+   * chunks, in a pool owned by this writer and capped at the number of cores.
+   * The pool is freed by closeWriter.  Requires libarrow 11 or later.  Default
+   * is to use the arrow CPU thread pool
+   *
+   * SYMBOLS_AS_DICTIONARY (long) - Flag indicating whether to write the utf8
+   * and large_utf8 fields whose data is a symbol list as dictionary arrays.
+   * The file is then created by the first writeRowGroup (or closeWriter if
+   * there are none) since its data determines the file's schema.  Later row
+   * groups must have symbol lists for the same fields.  Default 0
+   *
+   * @param parquet_file  String name of the parquet file to write
+   * @param schema_id     The schema identifier to use for the file
+   * @options             Dictionary of options or generic null (::) to use
+   * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
+   * mixed list of -7|-11|4|0h.
+   * @return              Writer handle (-6h)
+  */
+  EXP K openParquetWriter(K parquet_file, K schema_id, K options);
+
+  /**
+   * @brief Converts a kdb mixed list of arrow array data to an arrow table and
+   * writes it to a parquet writer as a new row group, which is flushed to the
+   * file before returning.  libarrow splits row groups longer than its maximum
+   * row group length.
+   *
+   * @param writer_id   Writer handle returned by openParquetWriter
+   * @param array_data  Mixed list of arrow array data, ordered in schema field
+   * number
+   * @return            NULL on success, error otherwise
+  */
+  EXP K writeRowGroup(K writer_id, K array_data);
+
+  /**
+   * @brief Closes a parquet writer, writing the file footer.  The file can't
+   * be read until its writer is closed.
+   *
+   * @param writer_id Writer handle returned by openParquetWriter
+   * @return          NULL on success, error otherwise
+  */
+  EXP K closeWriter(K writer_id);
+}
+
+#endif // __PARQUET_WRITER_H__
@@ -1,5 +1,8 @@
 #include <vector>
 #include <memory>
+#include <limits>
+#include <numeric>
+#include <algorithm>
 #include <iostream>
 
 #ifndef _WIN32
@@ -7,6 +10,7 @@
 #endif
 
 #include <parquet/arrow/reader.h>
+#include <parquet/arrow/schema.h>
 #include <parquet/arrow/writer.h>
 #include <parquet/exception.h>
 #include <arrow/pretty_print.h>
@@ -17,9 +21,12 @@
 #include <arrow/ipc/writer.h>
 #include <arrow/io/memory.h>
 #include <arrow/util/compression.h>
+#include <arrow/util/config.h>
 
 #include "TableData.h"
 #include "HelperFunctions.h"
+#include "ParquetFile.h"
+#include "ParquetFilter.h"
 #include "SchemaStore.h"
 #include "FieldStore.h"
 #include "DatatypeStore.h"
@@ -68,35 +75,10 @@ std::vector<std::shared_ptr<arrow::Array>> MakeArrays(std::shared_ptr<arrow::Sch
   return arrays;
 }
 
-std::vector<std::shared_ptr<arrow::ChunkedArray>> MakeChunkedArrays(
-      std::shared_ptr<arrow::Schema> schema
-    , K array_data
-    , kx::arrowkdb::TypeMappingOverride& type_overrides )
-{
-  if( array_data->t != 0 )
-    throw kx::arrowkdb::TypeCheck( "array_data not mixed list" );
-  if( array_data->n < schema->num_fields() )
-    throw kx::arrowkdb::TypeCheck( "array_data length less than number of schema fields" );
-  std::vector<std::shared_ptr<arrow::ChunkedArray>> chunked_arrays;
-  if( array_data->t == 0 && array_data->n == 0 ){
-    // Empty table
-  }
-  else{
-    // Only count up to the number of schema fields.  Additional trailing data
-    // in the kdb mixed list is ignored (to allow for ::)
-    for( auto i = 0; i < schema->num_fields(); ++i ){
-      auto k_array = kK( array_data )[i];
-      chunked_arrays.push_back( kx::arrowkdb::MakeChunkedArray( schema->field(i)->type(), k_array, type_overrides ) );
-    }
-  }
-
-  return chunked_arrays;
-}
-
 // Create a an arrow table from the arrow schema and mixed list of kdb array objects
-std::shared_ptr<arrow::Table> MakeTable(std::shared_ptr<arrow::Schema> schema, K array_data, kx::arrowkdb::TypeMappingOverride& type_overrides)
+std::shared_ptr<arrow::Table> MakeTable(std::shared_ptr<arrow::Schema> schema, K array_data, kx::arrowkdb::TypeMappingOverride& type_overrides, bool multithreaded = false)
 {
-  return arrow::Table::Make(schema, MakeChunkedArrays(schema, array_data, type_overrides));
+  return arrow::Table::Make(schema, kx::arrowkdb::MakeChunkedArrays(schema, array_data, type_overrides, multithreaded));
 }
 
 K prettyPrintTable(K schema_id, K array_data, K options)
@@ -152,23 +134,6 @@ K writeReadTable(K schema_id, K array_data, K options)
   KDB_EXCEPTION_CATCH;
 }
 
-arrow::Compression::type getCompressionType(const kx::arrowkdb::KdbOptions& options)
-{
-  // Convert the COMPRESSION option to an arrow compression type
-  std::string compression = "UNCOMPRESSED";
-  options.GetStringOption(kx::arrowkdb::Options::COMPRESSION, compression);
-  std::transform(compression.begin(), compression.end(), compression.begin(),
-    [](unsigned char c) { return std::tolower(c); }
-  );
-
-  arrow::Compression::type compression_type;
-  PARQUET_ASSIGN_OR_THROW(compression_type, arrow::util::Codec::GetCompressionType(compression));
-  if (!arrow::util::Codec::IsAvailable(compression_type))
-    throw kx::arrowkdb::KdbOptions::InvalidOption("Compression type " + compression + " not available");
-
-  return compression_type;
-}
-
 K writeParquet(K parquet_file, K schema_id, K array_data, K options)
 {
   KDB_EXCEPTION_TRY;
@@ -178,15 +143,10 @@ K writeParquet(K parquet_file, K schema_id, K array_data, K options)
   if (schema_id->t != -KI)
     return krr((S)"schema_id not -6h");
 
-  const auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
+  auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
   if (!schema)
     return krr((S)"unknown schema");
 
-  std::shared_ptr<arrow::io::FileOutputStream> outfile;
-  PARQUET_ASSIGN_OR_THROW(
-    outfile,
-    arrow::io::FileOutputStream::Open(kx::arrowkdb::GetKdbString(parquet_file)));
-
   // Parse the options
   auto write_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
 
@@ -194,44 +154,31 @@ K writeParquet(K parquet_file, K schema_id, K array_data, K options)
   int64_t parquet_chunk_size = 1024 * 1024; // default to 1MB
   write_options.GetIntOption(kx::arrowkdb::Options::PARQUET_CHUNK_SIZE, parquet_chunk_size);
 
-  // Set writer properties
-  parquet::WriterProperties::Builder parquet_props_builder;
-  parquet::ArrowWriterProperties::Builder arrow_props_builder;
-
-  // Parquet version
-  std::string parquet_version;
-  write_options.GetStringOption(kx::arrowkdb::Options::PARQUET_VERSION, parquet_version);
-  if (parquet_version == "V2.0") {
-    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_0);
-    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
-  } else if (parquet_version == "V2.4") {
-    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_4);
-    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
-  } else if (parquet_version == "V2.6") {
-    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_6);
-    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
-  } else if (parquet_version == "V2.LATEST") {
-    parquet_props_builder.version(parquet::ParquetVersion::PARQUET_2_LATEST);
-    parquet_props_builder.data_page_version(parquet::ParquetDataPageVersion::V2);
-  } else {
-    // Not using v2.0 so map timestamp(ns) to timestamp(us) with truncation
-    arrow_props_builder.coerce_timestamps(arrow::TimeUnit::MICRO);
-    arrow_props_builder.allow_truncated_timestamps();
-  }
-
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ write_options };
+  schema = kx::arrowkdb::ApplySymbolsAsDictionary(schema, array_data, type_overrides);
+
+  // Opening the writer applies the parquet writer properties.  Any thread pool
+  // of its own is declared first so that it outlives the writer.
+  std::shared_ptr<arrow::internal::ThreadPool> thread_pool;
+  auto writer = kx::arrowkdb::OpenParquetWriter(kx::arrowkdb::GetKdbString(parquet_file), schema, write_options, thread_pool);
 
   // Chunk size
   write_options.GetIntOption( kx::arrowkdb::Options::ARROW_CHUNK_ROWS, type_overrides.chunk_length );
 
-  auto parquet_props = parquet_props_builder.compression(getCompressionType(write_options))->build();
-  auto arrow_props = arrow_props_builder.build();
+  // Build the arrow arrays and encode the column chunks in parallel
+  int64_t multithreaded_write = 0;
+  write_options.GetIntOption(kx::arrowkdb::Options::PARQUET_MULTITHREADED_WRITE, multithreaded_write);
 
   // Create the arrow table
-  auto table = MakeTable(schema, array_data, type_overrides);
+  auto table = MakeTable(schema, array_data, type_overrides, multithreaded_write);
+
+  kx::arrowkdb::WriteParquetTable(writer.get(), *table, parquet_chunk_size, multithreaded_write);
+  PARQUET_THROW_NOT_OK(writer->Close());
 
-  PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), outfile, parquet_chunk_size, parquet_props, arrow_props));
+  // Release any zero copy kdb lists whose buffers were freed by arrow's threads
+  table.reset();
+  kx::arrowkdb::ReleaseKdbBuffers();
 
   return (K)0;
 
@@ -245,17 +192,8 @@ K readParquetSchema(K parquet_file)
   if (!kx::arrowkdb::IsKdbString(parquet_file))
     return krr((S)"parquet_file not 11h or 0 of 10h");
 
-  std::shared_ptr<arrow::io::ReadableFile> infile;
-  PARQUET_ASSIGN_OR_THROW(
-    infile,
-    arrow::io::ReadableFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-      arrow::default_memory_pool()));
-
-  std::unique_ptr<parquet::arrow::FileReader> reader;
-  PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-
-  std::shared_ptr<arrow::Schema> schema;
-  PARQUET_THROW_NOT_OK(reader->GetSchema(&schema));
+  // Schema is parsed from the cached file footer
+  auto schema = kx::arrowkdb::GetParquetSchema(kx::arrowkdb::GetKdbString(parquet_file));
 
   // Add each field from the table to the field store
   // Add each datatype from the table to the datatype store
@@ -279,16 +217,146 @@ K readParquetNumRowGroups(K parquet_file)
   if (!kx::arrowkdb::IsKdbString(parquet_file))
     return krr((S)"parquet_file not 11h or 0 of 10h");
 
-  std::shared_ptr<arrow::io::ReadableFile> infile;
-  PARQUET_ASSIGN_OR_THROW(
-    infile,
-    arrow::io::ReadableFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-      arrow::default_memory_pool()));
+  return ki(kx::arrowkdb::GetParquetMetadata(kx::arrowkdb::GetKdbString(parquet_file))->num_row_groups());
 
-  std::unique_ptr<parquet::arrow::FileReader> reader;
-  PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
+  KDB_EXCEPTION_CATCH;
+}
 
-  return ki(reader->num_row_groups());
+// Converts a decoded min/max statistic to a kdb atom of the type the arrow
+// field is read into
+K StatisticToKdb(const kx::arrowkdb::Options::FilterValue& value, std::shared_ptr<arrow::DataType> datatype)
+{
+  using kx::arrowkdb::Options::FilterValue;
+
+  switch (value.kind) {
+  case FilterValue::REAL:
+    return datatype->id() == arrow::Type::FLOAT ? ke(value.real) : kf(value.real);
+  case FilterValue::STRING:
+    switch (datatype->id()) {
+    case arrow::Type::BINARY:
+    case arrow::Type::LARGE_BINARY:
+    case arrow::Type::FIXED_SIZE_BINARY:
+    {
+      K bytes = ktn(KG, value.string.length());
+      memcpy(kG(bytes), value.string.data(), value.string.length());
+      return bytes;
+    }
+    default:
+      return kpn((S)value.string.data(), value.string.length());
+    }
+  default:
+    break;
+  }
+
+  switch (datatype->id()) {
+  case arrow::Type::BOOL:
+    return kb(value.integer != 0);
+  case arrow::Type::UINT8:
+  case arrow::Type::INT8:
+    return kg(static_cast<int>(value.integer));
+  case arrow::Type::UINT16:
+  case arrow::Type::INT16:
+    return kh(static_cast<int>(value.integer));
+  case arrow::Type::UINT32:
+  case arrow::Type::INT32:
+    return ki(static_cast<int>(value.integer));
+  case arrow::Type::DATE32:
+    return kd(static_cast<int>(value.integer));
+  case arrow::Type::TIME32:
+    return kt(static_cast<int>(value.integer));
+  case arrow::Type::DATE64:
+  case arrow::Type::TIMESTAMP:
+    return ktj(-KP, value.integer);
+  case arrow::Type::TIME64:
+  case arrow::Type::DURATION:
+    return ktj(-KN, value.integer);
+  default:
+    return kj(value.integer);
+  }
+}
+
+K readParquetStatistics(K parquet_file)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (!kx::arrowkdb::IsKdbString(parquet_file))
+    return krr((S)"parquet_file not 11h or 0 of 10h");
+
+  // Statistics are parsed from the cached file footer
+  const auto metadata = kx::arrowkdb::GetParquetMetadata(kx::arrowkdb::GetKdbString(parquet_file));
+  const auto schema = metadata->schema();
+
+  // Map each leaf column to the arrow field it is read into
+  parquet::arrow::SchemaManifest manifest;
+  PARQUET_THROW_NOT_OK(parquet::arrow::SchemaManifest::Make(schema, metadata->key_value_metadata(), parquet::ArrowReaderProperties(), &manifest));
+  std::vector<std::shared_ptr<arrow::DataType>> datatypes;
+  for (auto i = 0; i < metadata->num_columns(); ++i) {
+    const parquet::arrow::SchemaField* schema_field = nullptr;
+    PARQUET_THROW_NOT_OK(manifest.GetColumnField(i, &schema_field));
+    datatypes.push_back(schema_field->field->type());
+  }
+
+  // One row per row group and leaf column
+  const auto num_rows = static_cast<J>(metadata->num_row_groups()) * metadata->num_columns();
+  K row_group = ktn(KI, num_rows);
+  K column = ktn(KS, num_rows);
+  K num_values = ktn(KJ, num_rows);
+  K null_count = ktn(KJ, num_rows);
+  K distinct_count = ktn(KJ, num_rows);
+  K min_value = ktn(0, num_rows);
+  K max_value = ktn(0, num_rows);
+  K compressed_size = ktn(KJ, num_rows);
+  K uncompressed_size = ktn(KJ, num_rows);
+  K encodings = ktn(0, num_rows);
+  K codec = ktn(KS, num_rows);
+
+  J index = 0;
+  for (auto i = 0; i < metadata->num_row_groups(); ++i) {
+    const auto row_group_metadata = metadata->RowGroup(i);
+    for (auto j = 0; j < metadata->num_columns(); ++j, ++index) {
+      const auto column_chunk = row_group_metadata->ColumnChunk(j);
+      kI(row_group)[index] = i;
+      kS(column)[index] = ss((S)schema->Column(j)->path()->ToDotString().c_str());
+      kJ(num_values)[index] = column_chunk->num_values();
+      kJ(compressed_size)[index] = column_chunk->total_compressed_size();
+      kJ(uncompressed_size)[index] = column_chunk->total_uncompressed_size();
+      kS(codec)[index] = ss((S)arrow::util::Codec::GetCodecAsString(column_chunk->compression()).c_str());
+
+      const auto& chunk_encodings = column_chunk->encodings();
+      K k_encodings = ktn(KS, chunk_encodings.size());
+      for (size_t k = 0; k < chunk_encodings.size(); ++k)
+        kS(k_encodings)[k] = ss((S)parquet::EncodingToString(chunk_encodings[k]).c_str());
+      kK(encodings)[index] = k_encodings;
+
+      // Statistics which weren't written are returned as nulls
+      const auto stats = column_chunk->is_stats_set() ? column_chunk->statistics() : nullptr;
+      kJ(null_count)[index] = stats && stats->HasNullCount() ? stats->null_count() : nj;
+      kJ(distinct_count)[index] = stats && stats->HasDistinctCount() ? stats->distinct_count() : nj;
+
+      kx::arrowkdb::Options::FilterValue min_stat;
+      kx::arrowkdb::Options::FilterValue max_stat;
+      if (stats && kx::arrowkdb::GetMinMax(*stats, datatypes[j], min_stat, max_stat)) {
+        kK(min_value)[index] = StatisticToKdb(min_stat, datatypes[j]);
+        kK(max_value)[index] = StatisticToKdb(max_stat, datatypes[j]);
+      } else {
+        kK(min_value)[index] = ka(101);
+        kK(min_value)[index]->g = 0;
+        kK(max_value)[index] = ka(101);
+        kK(max_value)[index]->g = 0;
+      }
+    }
+  }
+
+  K names = ktn(KS, 11);
+  K data = ktn(0, 11);
+  const char* column_names[] = { "row_group", "column", "num_values", "null_count", "distinct_count", "min_value", "max_value", "compressed_size", "uncompressed_size", "encodings", "codec" };
+  K columns[] = { row_group, column, num_values, null_count, distinct_count, min_value, max_value, compressed_size, uncompressed_size, encodings, codec };
+  for (auto i = 0; i < 11; ++i) {
+    kS(names)[i] = ss((S)column_names[i]);
+    kK(data)[i] = columns[i];
+  }
+
+  return xT(xD(names, data));
 
   KDB_EXCEPTION_CATCH;
 }
@@ -303,55 +371,50 @@ K readParquetData(K parquet_file, K options)
   // Parse the options
   auto read_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
 
-  // Use multi threading
-  int64_t parquet_multithreaded_read = 0;
-  read_options.GetIntOption(kx::arrowkdb::Options::PARQUET_MULTITHREADED_READ, parquet_multithreaded_read);
-
-  // Use memmap
-  int64_t use_mmap = 0;
-  read_options.GetIntOption(kx::arrowkdb::Options::USE_MMAP, use_mmap);
-
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
 
-  std::shared_ptr<arrow::io::RandomAccessFile> infile;
-  if (use_mmap) {
-    PARQUET_ASSIGN_OR_THROW(
-      infile,
-      arrow::io::MemoryMappedFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-        arrow::io::FileMode::READ));
-  } else {
-    PARQUET_ASSIGN_OR_THROW(
-      infile,
-      arrow::io::ReadableFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-        arrow::default_memory_pool()));
-  }
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
 
-  std::unique_ptr<parquet::arrow::FileReader> reader;
-  PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
+  auto reader = kx::arrowkdb::OpenParquetFile(kx::arrowkdb::GetKdbString(parquet_file), read_options);
 
-  reader->set_use_threads(parquet_multithreaded_read);
+  // Row group predicate pushdown
+  std::vector<kx::arrowkdb::Options::FilterPredicate> filter;
+  read_options.GetFilterOptions(filter);
+
+  // Column projection
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
 
   std::shared_ptr<arrow::Table> table;
-  PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+  if (filter.empty() && column_names.empty())
+    PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+  else if (filter.empty())
+    PARQUET_THROW_NOT_OK(reader->ReadTable(kx::arrowkdb::GetParquetColumnIndices(reader.get(), column_names), &table));
+  else {
+    // Skip row groups using their statistics and page index then trim the
+    // rows of any pages excluded by the page index
+    std::vector<kx::arrowkdb::RowRanges> page_rows;
+    const auto rows = kx::arrowkdb::FilterRowGroups(reader.get(), filter, &page_rows);
+    if (column_names.empty())
+      PARQUET_THROW_NOT_OK(reader->ReadRowGroups(rows, &table));
+    else
+      PARQUET_THROW_NOT_OK(reader->ReadRowGroups(rows, kx::arrowkdb::GetParquetColumnIndices(reader.get(), column_names), &table));
+    table = kx::arrowkdb::TrimPageRows(reader.get(), rows, page_rows, table);
+  }
 
   const auto schema = table->schema();
   SchemaContainsNullable(schema);
-  const auto col_num = schema->num_fields();
-  K data = ktn(0, col_num);
-  for (auto i = 0; i < col_num; ++i) {
-    auto chunked_array = table->column(i);
-    kK(data)[i] = kx::arrowkdb::ReadChunkedArray(chunked_array, type_overrides);
-  }
+
+  const auto columns = kx::arrowkdb::SelectColumns(table, column_names);
+  K data = kx::arrowkdb::ReadChunkedArrays(columns, type_overrides, multithreaded_conversion);
 
   int64_t with_null_bitmap = 0;
   read_options.GetIntOption( kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap );
   if( with_null_bitmap ){
-    K bitmap = ktn( 0, col_num );
-    for( auto i = 0; i < col_num; ++i ){
-        auto chunked_array = table->column( i );
-        kK( bitmap )[i] = kx::arrowkdb::ReadChunkedArrayNullBitmap( chunked_array, type_overrides );
-    }
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap( columns, type_overrides, multithreaded_conversion );
     K array = data;
     data = ktn( 0, 2 );
     kK( data )[0] = array;
@@ -378,14 +441,7 @@ K readParquetColumn(K parquet_file, K column_index, K options)
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
 
-  std::shared_ptr<arrow::io::ReadableFile> infile;
-  PARQUET_ASSIGN_OR_THROW(
-    infile,
-    arrow::io::ReadableFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-      arrow::default_memory_pool()));
-
-  std::unique_ptr<parquet::arrow::FileReader> reader;
-  PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
+  auto reader = kx::arrowkdb::OpenParquetFile(kx::arrowkdb::GetKdbString(parquet_file), read_options);
 
   std::shared_ptr<::arrow::ChunkedArray> chunked_array;
   PARQUET_THROW_NOT_OK(reader->ReadColumn(column_index->i, &chunked_array));
@@ -423,62 +479,142 @@ K readParquetRowGroups(K parquet_file, K row_groups, K columns, K options)
   // Parse the options
   auto read_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
 
-  // Use multi threading
-  int64_t parquet_multithreaded_read = 0;
-  read_options.GetIntOption(kx::arrowkdb::Options::PARQUET_MULTITHREADED_READ, parquet_multithreaded_read);
-
-  // Use memmap
-  int64_t use_mmap = 0;
-  read_options.GetIntOption(kx::arrowkdb::Options::USE_MMAP, use_mmap);
-
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
 
-  std::shared_ptr<arrow::io::RandomAccessFile> infile;
-  if (use_mmap) {
-    PARQUET_ASSIGN_OR_THROW(
-      infile,
-      arrow::io::MemoryMappedFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-        arrow::io::FileMode::READ));
-  } else {
-    PARQUET_ASSIGN_OR_THROW(
-      infile,
-      arrow::io::ReadableFile::Open(kx::arrowkdb::GetKdbString(parquet_file),
-        arrow::default_memory_pool()));
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
+  auto reader = kx::arrowkdb::OpenParquetFile(kx::arrowkdb::GetKdbString(parquet_file), read_options);
+
+  // Row group predicate pushdown, restricting the requested row groups to
+  // those which may contain matching rows
+  bool all_row_groups = row_groups->t == 101;
+  std::vector<kx::arrowkdb::Options::FilterPredicate> filter;
+  read_options.GetFilterOptions(filter);
+  std::vector<kx::arrowkdb::RowRanges> page_rows;
+  if (!filter.empty()) {
+    rows = all_row_groups ? kx::arrowkdb::FilterRowGroups(reader.get(), filter, &page_rows) : kx::arrowkdb::FilterRowGroups(reader.get(), filter, rows, &page_rows);
+    all_row_groups = false;
   }
 
-  std::unique_ptr<parquet::arrow::FileReader> reader;
-  PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(infile, arrow::default_memory_pool(), &reader));
-
-  reader->set_use_threads(parquet_multithreaded_read);
+  // Column projection by name, as an alternative to the column indices
+  bool all_columns = columns->t == 101;
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+  if (!column_names.empty()) {
+    if (!all_columns)
+      return krr((S)"columns and COLUMNS option both specified");
+    cols = kx::arrowkdb::GetParquetColumnIndices(reader.get(), column_names);
+    all_columns = false;
+  }
 
   std::shared_ptr<arrow::Table> table;
-  if (row_groups->t == 101 && columns->t == 101)
+  if (all_row_groups && all_columns)
     PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
-  else if (row_groups->t == 101)
+  else if (all_row_groups)
     PARQUET_THROW_NOT_OK(reader->ReadTable(cols, &table));
-  else if (columns->t == 101)
+  else if (all_columns)
     PARQUET_THROW_NOT_OK(reader->ReadRowGroups(rows, &table));
   else
     PARQUET_THROW_NOT_OK(reader->ReadRowGroups(rows, cols, &table));
 
+  // Trim the rows of any pages excluded by the page index
+  if (!filter.empty())
+    table = kx::arrowkdb::TrimPageRows(reader.get(), rows, page_rows, table);
+
   const auto schema = table->schema();
   SchemaContainsNullable(schema);
-  const auto col_num = schema->num_fields();
-  K data = ktn(0, col_num);
-  for (auto i = 0; i < col_num; ++i) {
-    auto chunked_array = table->column(i);
-    kK(data)[i] = kx::arrowkdb::ReadChunkedArray(chunked_array, type_overrides);
-  }
+
+  const auto table_columns = kx::arrowkdb::SelectColumns(table, column_names);
+  K data = kx::arrowkdb::ReadChunkedArrays(table_columns, type_overrides, multithreaded_conversion);
 
   int64_t with_null_bitmap = 0;
   read_options.GetIntOption(kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap);
   if (with_null_bitmap) {
-    K bitmap = ktn(0, col_num);
-    for (auto i = 0; i < col_num; ++i) {
-      auto chunked_array = table->column(i);
-      kK(bitmap)[i] = kx::arrowkdb::ReadChunkedArrayNullBitmap(chunked_array, type_overrides);
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap(table_columns, type_overrides, multithreaded_conversion);
+    K array = data;
+    data = ktn(0, 2);
+    kK(data)[0] = array;
+    kK(data)[1] = bitmap;
+  }
+
+  return data;
+
+  KDB_EXCEPTION_CATCH;
+}
+
+K readParquetRows(K parquet_file, K start, K num_rows, K options)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (!kx::arrowkdb::IsKdbString(parquet_file))
+    return krr((S)"parquet_file not 11h or 0 of 10h");
+  if (start->t != -KJ)
+    return krr((S)"start not -7h");
+  if (num_rows->t != -KJ)
+    return krr((S)"num_rows not -7h");
+  if (start->j < 0 || num_rows->j < 0)
+    return krr((S)"negative start or num_rows");
+
+  // Parse the options
+  auto read_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
+
+  // Type mapping overrides
+  kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
+
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
+  auto reader = kx::arrowkdb::OpenParquetFile(kx::arrowkdb::GetKdbString(parquet_file), read_options);
+
+  // Use the row counts in the footer to find the row groups covering the
+  // range, clamped to the end of the file
+  const auto metadata = reader->parquet_reader()->metadata();
+  const int64_t file_rows = metadata->num_rows();
+  const int64_t end = start->j >= file_rows ? file_rows : start->j + std::min(num_rows->j, file_rows - start->j);
+  std::vector<int> rows;
+  int64_t first_row = 0;
+  int64_t row_group_start = 0;
+  for (auto i = 0; i < metadata->num_row_groups() && row_group_start < end; ++i) {
+    const auto row_group_rows = metadata->RowGroup(i)->num_rows();
+    if (row_group_start + row_group_rows > start->j) {
+      if (rows.empty())
+        first_row = row_group_start;
+      rows.push_back(i);
     }
+    row_group_start += row_group_rows;
+  }
+
+  // Column projection
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+
+  std::shared_ptr<arrow::Table> table;
+  if (column_names.empty())
+    PARQUET_THROW_NOT_OK(reader->ReadRowGroups(rows, &table));
+  else
+    PARQUET_THROW_NOT_OK(reader->ReadRowGroups(rows, kx::arrowkdb::GetParquetColumnIndices(reader.get(), column_names), &table));
+
+  // Trim the leading and trailing rows outside the range from the covering row
+  // groups (zero copy)
+  if (rows.empty())
+    table = table->Slice(0, 0);
+  else
+    table = table->Slice(start->j - first_row, end - start->j);
+
+  const auto schema = table->schema();
+  SchemaContainsNullable(schema);
+
+  const auto columns = kx::arrowkdb::SelectColumns(table, column_names);
+  K data = kx::arrowkdb::ReadChunkedArrays(columns, type_overrides, multithreaded_conversion);
+
+  int64_t with_null_bitmap = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap);
+  if (with_null_bitmap) {
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap(columns, type_overrides, multithreaded_conversion);
     K array = data;
     data = ktn(0, 2);
     kK(data)[0] = array;
@@ -499,7 +635,7 @@ K writeArrow(K arrow_file, K schema_id, K array_data, K options)
   if (schema_id->t != -KI)
     return krr((S)"schema_id not -6h");
 
-  const auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
+  auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
   if (!schema)
     return krr((S)"unknown schema");
 
@@ -508,6 +644,7 @@ K writeArrow(K arrow_file, K schema_id, K array_data, K options)
 
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ write_options };
+  schema = kx::arrowkdb::ApplySymbolsAsDictionary(schema, array_data, type_overrides);
 
   // Output file
   std::shared_ptr<arrow::io::FileOutputStream> outfile;
@@ -517,7 +654,7 @@ K writeArrow(K arrow_file, K schema_id, K array_data, K options)
 
   // Codec setup including compression
   std::unique_ptr<arrow::util::Codec> codec;
-  PARQUET_ASSIGN_OR_THROW(codec, arrow::util::Codec::Create(getCompressionType(write_options)));
+  PARQUET_ASSIGN_OR_THROW(codec, arrow::util::Codec::Create(kx::arrowkdb::GetCompressionType(write_options)));
   arrow::ipc::IpcWriteOptions ipc_write_options;
   ipc_write_options.codec = std::shared_ptr<arrow::util::Codec>(codec.release());
 
@@ -553,7 +690,7 @@ K writeArrow(K arrow_file, K schema_id, K array_data, K options)
     PARQUET_THROW_NOT_OK(writer->WriteRecordBatch(*batch));
   }
   else{
-    auto chunked_arrays = MakeChunkedArrays( schema, array_data, type_overrides );
+    auto chunked_arrays = kx::arrowkdb::MakeChunkedArrays( schema, array_data, type_overrides );
 
     auto len = check_length( chunked_arrays );
     if( len < 0 ){
@@ -619,6 +756,10 @@ K readArrowData(K arrow_file, K options)
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
 
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
   std::shared_ptr<arrow::io::RandomAccessFile> infile;
   if (use_mmap) {
     PARQUET_ASSIGN_OR_THROW(
@@ -632,8 +773,18 @@ K readArrowData(K arrow_file, K options)
         arrow::default_memory_pool()));
   }
 
+  // Column projection, only the selected fields are decoded
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+  auto ipc_read_options = arrow::ipc::IpcReadOptions::Defaults();
+  if (!column_names.empty()) {
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> schema_reader;
+    PARQUET_ASSIGN_OR_THROW(schema_reader, arrow::ipc::RecordBatchFileReader::Open(infile));
+    ipc_read_options.included_fields = kx::arrowkdb::GetFieldIndices(schema_reader->schema(), column_names);
+  }
+
   std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader;
-  PARQUET_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchFileReader::Open(infile));
+  PARQUET_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchFileReader::Open(infile, ipc_read_options));
 
   // Get all the record batches in advance
   std::vector<std::shared_ptr<arrow::RecordBatch>> all_batches;
@@ -647,28 +798,25 @@ K readArrowData(K arrow_file, K options)
   // arrays across all batches
   const auto schema = reader->schema();
   SchemaContainsNullable(schema);
-  const auto col_num = schema->num_fields();
-  K data = ktn(0, col_num);
-  for (auto i = 0; i < col_num; ++i) {
+  std::vector<int> column_indices(schema->num_fields());
+  std::iota(column_indices.begin(), column_indices.end(), 0);
+  if (!column_names.empty())
+    column_indices = kx::arrowkdb::GetFieldIndices(schema, column_names);
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (auto i : column_indices) {
     arrow::ArrayVector column_arrays;
     for (auto batch : all_batches)
       column_arrays.push_back(batch->column(i));
-    auto chunked_array = std::make_shared<arrow::ChunkedArray>(column_arrays);
-    // Convert the chunked array to kdb object
-    kK(data)[i] = kx::arrowkdb::ReadChunkedArray(chunked_array, type_overrides);
+    columns.push_back(std::make_shared<arrow::ChunkedArray>(column_arrays));
   }
 
+  // Convert the chunked arrays to kdb objects
+  K data = kx::arrowkdb::ReadChunkedArrays(columns, type_overrides, multithreaded_conversion);
+
   int64_t with_null_bitmap = 0;
   read_options.GetIntOption( kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap );
   if( with_null_bitmap ){
-    K bitmap = ktn( 0, col_num );
-    for( auto i = 0; i < col_num; ++i ){
-        arrow::ArrayVector column_arrays;
-        for( auto batch: all_batches )
-          column_arrays.push_back( batch->column( i ) );
-        auto chunked_array = std::make_shared<arrow::ChunkedArray>( column_arrays );
-        kK( bitmap )[i] = kx::arrowkdb::ReadChunkedArrayNullBitmap( chunked_array, type_overrides );
-    }
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap( columns, type_overrides, multithreaded_conversion );
     K array = data;
     data = ktn( 0, 2 );
     kK( data )[0] = array;
@@ -680,6 +828,114 @@ K readArrowData(K arrow_file, K options)
   KDB_EXCEPTION_CATCH;
 }
 
+K readArrowRows(K arrow_file, K start, K num_rows, K options)
+{
+  KDB_EXCEPTION_TRY;
+
+  if (!kx::arrowkdb::IsKdbString(arrow_file))
+    return krr((S)"arrow_file not 11h or 0 of 10h");
+  if (start->t != -KJ)
+    return krr((S)"start not -7h");
+  if (num_rows->t != -KJ)
+    return krr((S)"num_rows not -7h");
+  if (start->j < 0 || num_rows->j < 0)
+    return krr((S)"negative start or num_rows");
+
+  // Parse the options
+  auto read_options = kx::arrowkdb::KdbOptions(options, kx::arrowkdb::Options::string_options, kx::arrowkdb::Options::int_options);
+
+  // Use memmap
+  int64_t use_mmap = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::USE_MMAP, use_mmap);
+
+  // Type mapping overrides
+  kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
+
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
+  std::shared_ptr<arrow::io::RandomAccessFile> infile;
+  if (use_mmap) {
+    PARQUET_ASSIGN_OR_THROW(
+      infile,
+      arrow::io::MemoryMappedFile::Open(kx::arrowkdb::GetKdbString(arrow_file),
+        arrow::io::FileMode::READ));
+  } else {
+    PARQUET_ASSIGN_OR_THROW(
+      infile,
+      arrow::io::ReadableFile::Open(kx::arrowkdb::GetKdbString(arrow_file),
+        arrow::default_memory_pool()));
+  }
+
+  // Column projection, only the selected fields are decoded
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+  auto ipc_read_options = arrow::ipc::IpcReadOptions::Defaults();
+  if (!column_names.empty()) {
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> schema_reader;
+    PARQUET_ASSIGN_OR_THROW(schema_reader, arrow::ipc::RecordBatchFileReader::Open(infile));
+    ipc_read_options.included_fields = kx::arrowkdb::GetFieldIndices(schema_reader->schema(), column_names);
+  }
+
+  std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader;
+  PARQUET_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchFileReader::Open(infile, ipc_read_options));
+
+  // The IPC footer doesn't record the length of each record batch so read the
+  // batches in order, keeping only those which overlap the range and stopping
+  // once its end has been reached
+  const int64_t end = start->j + std::min(num_rows->j, std::numeric_limits<int64_t>::max() - start->j);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> range_batches;
+  int64_t first_row = 0;
+  int64_t batch_start = 0;
+  for (auto i = 0; i < reader->num_record_batches() && batch_start < end; ++i) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    PARQUET_ASSIGN_OR_THROW(batch, reader->ReadRecordBatch(i));
+    if (batch_start + batch->num_rows() > start->j) {
+      if (range_batches.empty())
+        first_row = batch_start;
+      range_batches.push_back(batch);
+    }
+    batch_start += batch->num_rows();
+  }
+  const int64_t offset = range_batches.empty() ? 0 : start->j - first_row;
+  const int64_t length = range_batches.empty() ? 0 : std::min(end, batch_start) - start->j;
+
+  // Created a chunked array for each column from the overlapping batches and
+  // trim the rows outside the range (zero copy)
+  const auto schema = reader->schema();
+  SchemaContainsNullable(schema);
+  std::vector<int> column_indices(schema->num_fields());
+  std::iota(column_indices.begin(), column_indices.end(), 0);
+  if (!column_names.empty())
+    column_indices = kx::arrowkdb::GetFieldIndices(schema, column_names);
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (auto i : column_indices) {
+    arrow::ArrayVector column_arrays;
+    for (auto batch : range_batches)
+      column_arrays.push_back(batch->column(i));
+    auto chunked_array = std::make_shared<arrow::ChunkedArray>(column_arrays, schema->field(i)->type());
+    columns.push_back(chunked_array->Slice(offset, length));
+  }
+
+  // Convert the chunked arrays to kdb objects
+  K data = kx::arrowkdb::ReadChunkedArrays(columns, type_overrides, multithreaded_conversion);
+
+  int64_t with_null_bitmap = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap);
+  if (with_null_bitmap) {
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap(columns, type_overrides, multithreaded_conversion);
+    K array = data;
+    data = ktn(0, 2);
+    kK(data)[0] = array;
+    kK(data)[1] = bitmap;
+  }
+
+  return data;
+
+  KDB_EXCEPTION_CATCH;
+}
+
 K serializeArrow(K schema_id, K array_data, K options)
 {
   KDB_EXCEPTION_TRY;
@@ -687,7 +943,7 @@ K serializeArrow(K schema_id, K array_data, K options)
   if (schema_id->t != -KI)
     return krr((S)"schema_id not -6h");
 
-  const auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
+  auto schema = kx::arrowkdb::GetSchemaStore()->Find(schema_id->i);
   if (!schema)
     return krr((S)"unknown schema");
 
@@ -696,6 +952,7 @@ K serializeArrow(K schema_id, K array_data, K options)
 
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ write_options };
+  schema = kx::arrowkdb::ApplySymbolsAsDictionary(schema, array_data, type_overrides);
 
   // Output buffer
   std::shared_ptr<arrow::ResizableBuffer> buffer;
@@ -706,7 +963,7 @@ K serializeArrow(K schema_id, K array_data, K options)
 
   // Codec setup including compression
   std::unique_ptr<arrow::util::Codec> codec;
-  PARQUET_ASSIGN_OR_THROW(codec, arrow::util::Codec::Create(getCompressionType(write_options)));
+  PARQUET_ASSIGN_OR_THROW(codec, arrow::util::Codec::Create(kx::arrowkdb::GetCompressionType(write_options)));
   auto ipc_write_options = arrow::ipc::IpcWriteOptions::Defaults();
   ipc_write_options.codec = std::move(codec);
 
@@ -742,7 +999,7 @@ K serializeArrow(K schema_id, K array_data, K options)
     PARQUET_THROW_NOT_OK(writer->WriteRecordBatch(*batch));
   }
   else{
-    auto chunked_arrays = MakeChunkedArrays( schema, array_data, type_overrides );
+    auto chunked_arrays = kx::arrowkdb::MakeChunkedArrays( schema, array_data, type_overrides );
 
     auto len = check_length( chunked_arrays );
     if( len < 0 ){
@@ -804,9 +1061,24 @@ K parseArrowData(K char_array, K options)
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
 
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
+  // Column projection, only the selected fields are decoded
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+  auto ipc_read_options = arrow::ipc::IpcReadOptions::Defaults();
+  if (!column_names.empty()) {
+    auto schema_buf_reader = std::make_shared<arrow::io::BufferReader>(kG(char_array), char_array->n);
+    std::shared_ptr<arrow::ipc::RecordBatchReader> schema_reader;
+    PARQUET_ASSIGN_OR_THROW(schema_reader, arrow::ipc::RecordBatchStreamReader::Open(schema_buf_reader));
+    ipc_read_options.included_fields = kx::arrowkdb::GetFieldIndices(schema_reader->schema(), column_names);
+  }
+
   auto buf_reader = std::make_shared<arrow::io::BufferReader>(kG(char_array), char_array->n);
   std::shared_ptr<arrow::ipc::RecordBatchReader> reader;
-  PARQUET_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchStreamReader::Open(buf_reader));
+  PARQUET_ASSIGN_OR_THROW(reader, arrow::ipc::RecordBatchStreamReader::Open(buf_reader, ipc_read_options));
 
   // Get all the record batches in advance
   std::vector<std::shared_ptr<arrow::RecordBatch>> all_batches;
@@ -816,28 +1088,25 @@ K parseArrowData(K char_array, K options)
   // arrays across all batches
   auto schema = reader->schema();
   SchemaContainsNullable(schema);
-  auto col_num = schema->num_fields();
-  K data = ktn(0, col_num);
-  for (auto i = 0; i < col_num; ++i) {
+  std::vector<int> column_indices(schema->num_fields());
+  std::iota(column_indices.begin(), column_indices.end(), 0);
+  if (!column_names.empty())
+    column_indices = kx::arrowkdb::GetFieldIndices(schema, column_names);
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (auto i : column_indices) {
     arrow::ArrayVector column_arrays;
     for (auto batch : all_batches)
       column_arrays.push_back(batch->column(i));
-    auto chunked_array = std::make_shared<arrow::ChunkedArray>(column_arrays);
-    // Convert the chunked array to kdb object
-    kK(data)[i] = kx::arrowkdb::ReadChunkedArray(chunked_array, type_overrides);
+    columns.push_back(std::make_shared<arrow::ChunkedArray>(column_arrays));
   }
 
+  // Convert the chunked arrays to kdb objects
+  K data = kx::arrowkdb::ReadChunkedArrays(columns, type_overrides, multithreaded_conversion);
+
   int64_t with_null_bitmap = 0;
   read_options.GetIntOption( kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap );
   if( with_null_bitmap ){
-    K bitmap = ktn( 0, col_num );
-    for( auto i = 0; i < col_num; ++i ){
-        arrow::ArrayVector column_arrays;
-        for( auto batch: all_batches )
-          column_arrays.push_back( batch->column( i ) );
-        auto chunked_array = std::make_shared<arrow::ChunkedArray>( column_arrays );
-        kK( bitmap )[i] = kx::arrowkdb::ReadChunkedArrayNullBitmap( chunked_array, type_overrides );
-    }
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap( columns, type_overrides, multithreaded_conversion );
     K array = data;
     data = ktn( 0, 2 );
     kK( data )[0] = array;
@@ -869,6 +1138,10 @@ K readORCData(K orc_file, K options)
   // Type mapping overrides
   kx::arrowkdb::TypeMappingOverride type_overrides{ read_options };
 
+  // Multithreaded conversion to kdb
+  int64_t multithreaded_conversion = 0;
+  read_options.GetIntOption(kx::arrowkdb::Options::MULTITHREADED_CONVERSION, multithreaded_conversion);
+
   std::shared_ptr<arrow::io::RandomAccessFile> infile;
   if (use_mmap) {
     PARQUET_ASSIGN_OR_THROW(
@@ -886,27 +1159,32 @@ K readORCData(K orc_file, K options)
   std::unique_ptr<arrow::adapters::orc::ORCFileReader> reader;
   PARQUET_ASSIGN_OR_THROW(reader, arrow::adapters::orc::ORCFileReader::Open(infile, arrow::default_memory_pool()));
 
-  // Read entire file as a single Arrow table
+  // Column projection
+  std::vector<std::string> column_names;
+  read_options.GetSymbolListOption(kx::arrowkdb::Options::COLUMNS, column_names);
+
+  // Read entire file (or only the selected columns) as a single Arrow table
   std::shared_ptr<arrow::Table> table;
-  PARQUET_ASSIGN_OR_THROW(table, reader->Read());
+  if (column_names.empty()) {
+    PARQUET_ASSIGN_OR_THROW(table, reader->Read());
+  } else {
+    // Check the names before reading since the ORC reader ignores unknown ones
+    std::shared_ptr<arrow::Schema> file_schema;
+    PARQUET_ASSIGN_OR_THROW(file_schema, reader->ReadSchema());
+    kx::arrowkdb::GetFieldIndices(file_schema, column_names);
+    PARQUET_ASSIGN_OR_THROW(table, reader->Read(column_names));
+  }
 
   const auto schema = table->schema();
   SchemaContainsNullable(schema);
-  const auto col_num = schema->num_fields();
-  K data = ktn(0, col_num);
-  for (auto i = 0; i < col_num; ++i) {
-    auto chunked_array = table->column(i);
-    kK(data)[i] = kx::arrowkdb::ReadChunkedArray(chunked_array, type_overrides);
-  }
+
+  const auto columns = kx::arrowkdb::SelectColumns(table, column_names);
+  K data = kx::arrowkdb::ReadChunkedArrays(columns, type_overrides, multithreaded_conversion);
 
   int64_t with_null_bitmap = 0;
   read_options.GetIntOption( kx::arrowkdb::Options::WITH_NULL_BITMAP, with_null_bitmap );
   if( with_null_bitmap ){
-    K bitmap = ktn( 0, col_num );
-    for( auto i = 0; i < col_num; ++i ){
-        auto chunked_array = table->column( i );
-        kK( bitmap )[i] = kx::arrowkdb::ReadChunkedArrayNullBitmap( chunked_array, type_overrides );
-    }
+    K bitmap = kx::arrowkdb::ReadChunkedArraysNullBitmap( columns, type_overrides, multithreaded_conversion );
     K array = data;
     data = ktn( 0, 2 );
     kK( data )[0] = array;
@@ -987,7 +1265,7 @@ K writeORC(K orc_file, K schema_id, K array_data, K options)
   write_options.GetIntOption(kx::arrowkdb::Options::ORC_CHUNK_SIZE, orc_chunk_size);
 
   auto used_write = arrow::adapters::orc::WriteOptions();
-  used_write.compression = getCompressionType(write_options);
+  used_write.compression = kx::arrowkdb::GetCompressionType(write_options);
   used_write.batch_size = orc_chunk_size;
 
   std::unique_ptr<arrow::adapters::orc::ORCFileWriter> writer;
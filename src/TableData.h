@@ -25,6 +25,11 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
    * @param schema_id   The schema identifier to use for the intermediate arrow
    * table
    * @param array_data  Mixed list of arrow array data to be written to the
@@ -54,6 +59,11 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
    * @param schema_id   The schema identifier to use for the intermediate arrow
    * table
    * @param array_data  Mixed list of arrow array data to be written to the
@@ -102,6 +112,62 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * PARQUET_DATA_PAGE_SIZE (long) - Approximate size in bytes of the encoded
+   * data pages within a column chunk.  Default is the libarrow default (1MB)
+   *
+   * PARQUET_WRITE_PAGE_INDEX (long) - Flag indicating whether to write the
+   * page index (column index and offset index) for each column chunk, used by
+   * FILTER to skip row groups and trim the rows of data pages which cannot
+   * match.  Requires
+   * libarrow 12 or later.  Default 0
+   *
+   * PARQUET_BLOOM_FILTER_COLUMNS (symbol list) - Names of the top level fields
+   * to write column chunk bloom filters for, used by FILTER to skip row groups
+   * for equality and `in` predicates.  Requires libarrow 21 or later.
+   *
+   * PARQUET_BLOOM_FILTER_NDV (long) - Expected number of distinct values per
+   * column chunk, used to size the bloom filters.  Default is the libarrow
+   * default
+   *
+   * PARQUET_COMPRESSION_LEVEL (long) - Compression level of the COMPRESSION
+   * codec.  Default is the codec default
+   *
+   * PARQUET_DICTIONARY_PAGE_SIZE_LIMIT (long) - Maximum size in bytes of a
+   * dictionary page before falling back to the non-dictionary encoding.
+   * Default is the libarrow default
+   *
+   * PARQUET_MAX_ROW_GROUP_LENGTH (long) - Maximum number of rows in a row
+   * group.  Default is the libarrow default
+   *
+   * PARQUET_COLUMN_OPTIONS (dict) - Per field settings keyed by top level
+   * field name (applied to all of a nested field's leaf columns) or dotted
+   * leaf column path, each a dictionary of COMPRESSION (symbol),
+   * COMPRESSION_LEVEL (long), DICTIONARY (long) and ENCODING (symbol, one of
+   * PLAIN, RLE, DELTA_BINARY_PACKED, DELTA_LENGTH_BYTE_ARRAY, DELTA_BYTE_ARRAY
+   * or BYTE_STREAM_SPLIT)
+   *
+   * PARQUET_MULTITHREADED_WRITE (long) - Flag indicating whether to build the
+   * arrow arrays from the kdb lists in parallel and encode and compress the
+   * column chunks of each row group in parallel.  The row group is buffered
+   * and its column chunks are flushed to the file in order, so the file is
+   * identical to a single threaded write.  Parallel encoding requires
+   * libarrow 11 or later.  Default 0
+   *
+   * PARQUET_WRITE_THREADS (long) - Number of threads used to encode the column
+   * chunks when PARQUET_MULTITHREADED_WRITE is set, in a pool created for this
+   * write and capped at the number of cores.  Requires libarrow 11 or later.
+   * Default is to use the arrow CPU thread pool
+   *
+   * SYMBOLS_AS_DICTIONARY (long) - Flag indicating whether to write the utf8
+   * and large_utf8 fields whose data is a symbol list as dictionary(utf8,
+   * int32) arrays.  The distinct symbols are found by their interned
+   * pointers and are dictionary encoded in the file.  Default 0
+   *
    * @param parquet_file  String name of the parquet file to write
    * @param schema_id     The schema identifier
    * @param array_data    Mixed list of arrow array data to be written to the
@@ -114,7 +180,8 @@ extern "C"
   EXP K writeParquet(K parquet_file, K schema_id, K array_data, K options);
 
   /**
-   * @brief Reads the arrow schema from the specified parquet file
+   * @brief Reads the arrow schema from the specified parquet file.  The schema
+   * is held in the parquet metadata cache until the file changes.
    *
    * @param parquet_file  String name of the parquet file to read
    * @return              Schema identifier
@@ -134,10 +201,51 @@ extern "C"
    * mapped in.  This can improve performance on systems which support mmap.
    * Default 0
    *
+   * PARQUET_PRE_BUFFER, PARQUET_CACHE_HOLE_SIZE_LIMIT,
+   * PARQUET_CACHE_RANGE_SIZE_LIMIT, PARQUET_BUFFERED_STREAM,
+   * PARQUET_BUFFER_SIZE, PARQUET_BATCH_SIZE (long) - Parquet reader I/O
+   * settings, see OpenParquetFile
+   *
    * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * FILTER (list) - Predicate or list of predicates, each of the form
+   * (operator;column;value), used to skip row groups whose column chunk
+   * statistics show they cannot contain matching rows.  Operators supported:
+   * `=`, `<`, `<=`, `>`, `>=` (or `eq`, `lt`, `le`, `gt`, `ge`), `within` and
+   * `in`.  All predicates must be satisfied.  Where the file has a page index
+   * it is also used to skip row groups, and the rows of data pages which
+   * cannot match are trimmed after decoding.  Other rows are returned
+   * unfiltered.
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
    * @param parquet_file  String name of the parquet file to read
    * @options             Dictionary of options or generic null (::) to use
    * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
@@ -151,10 +259,36 @@ extern "C"
    *
    * Supported options:
    *
+   * PARQUET_MULTITHREADED_READ (long) - Flag indicating whether the parquet
+   * reader should run in multithreaded mode.  Default 0
+   *
+   * USE_MMAP (long) - Flag indicating whether the parquet file should be memory
+   * mapped in.  Default 0
+   *
    * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
    * @param parquet_file  String name of the parquet file to read
    * @param column_index  The index of the column to be read
    * @options             Dictionary of options or generic null (::) to use
@@ -172,6 +306,21 @@ extern "C"
   */
   EXP K readParquetNumRowGroups(K parquet_file);
 
+  /**
+   * @brief Reads the row group and column chunk statistics from a parquet
+   * file's metadata, without reading any data.  The min_value and max_value are
+   * converted to the kdb type of the field the column is read into, using the
+   * same temporal conversions as the data readers.  Statistics which weren't
+   * written are returned as nulls (::) or 0Nj.
+   *
+   * @param parquet_file  String name of the parquet file to read
+   * @return              kdb table with one row per row group and leaf
+   * column: row_group, column, num_values, null_count, distinct_count,
+   * min_value, max_value, compressed_size, uncompressed_size, encodings and
+   * codec
+  */
+  EXP K readParquetStatistics(K parquet_file);
+
   /**
    * @brief Reads a set of row groups from a parquet file
    *
@@ -185,10 +334,51 @@ extern "C"
    * mapped in.  This can improve performance on systems which support mmap.
    * Default 0
    *
+   * PARQUET_PRE_BUFFER, PARQUET_CACHE_HOLE_SIZE_LIMIT,
+   * PARQUET_CACHE_RANGE_SIZE_LIMIT, PARQUET_BUFFERED_STREAM,
+   * PARQUET_BUFFER_SIZE, PARQUET_BATCH_SIZE (long) - Parquet reader I/O
+   * settings, see OpenParquetFile
+   *
    * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * FILTER (list) - Predicate or list of predicates, each of the form
+   * (operator;column;value), used to skip row groups whose column chunk
+   * statistics show they cannot contain matching rows.  Operators supported:
+   * `=`, `<`, `<=`, `>`, `>=` (or `eq`, `lt`, `le`, `gt`, `ge`), `within` and
+   * `in`.  All predicates must be satisfied.  Where the file has a page index
+   * it is also used to skip row groups, and the rows of data pages which
+   * cannot match are trimmed after decoding.  Other rows are returned
+   * unfiltered.
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
    * @param parquet_file  String name of the parquet file to read
    * @param row_groups    Integer list (6h) of row groups indices to read, or
    * generic null (::) to read all row groups
@@ -201,6 +391,66 @@ extern "C"
   */
   EXP K readParquetRowGroups(K parquet_file, K row_groups, K columns, K options);
 
+  /**
+   * @brief Reads a range of rows from a parquet file.  The row counts in the
+   * file's footer are used to find the row groups covering the range, only
+   * those row groups are read and the rows outside the range are then trimmed.
+   * A range extending beyond the end of the file is truncated.
+   *
+   * Supported options:
+   *
+   * PARQUET_MULTITHREADED_READ (long) - Flag indicating whether the parquet
+   * reader should run in multithreaded mode.  Default 0
+   *
+   * USE_MMAP (long) - Flag indicating whether the parquet file should be memory
+   * mapped in.  Default 0
+   *
+   * PARQUET_PRE_BUFFER, PARQUET_CACHE_HOLE_SIZE_LIMIT,
+   * PARQUET_CACHE_RANGE_SIZE_LIMIT, PARQUET_BUFFERED_STREAM,
+   * PARQUET_BUFFER_SIZE, PARQUET_BATCH_SIZE (long) - Parquet reader I/O
+   * settings, see OpenParquetFile
+   *
+   * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
+   * default type mapping for the arrow decimal128 datatype and instead
+   * represent it as a double (9h).  Default 0.
+   *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
+   * @param parquet_file  String name of the parquet file to read
+   * @param start         Index of the first row to read (-7h)
+   * @param num_rows      Maximum number of rows to read (-7h)
+   * @options             Dictionary of options or generic null (::) to use
+   * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
+   * mixed list of -7|-11|4h.
+   * @return              Mixed list of arrow array objects
+  */
+  EXP K readParquetRows(K parquet_file, K start, K num_rows, K options);
+
   /**
    * @brief Creates an arrow IPC record batch file with the specified arrow
    * schema and populates it from a mixed list of arrow array objects.
@@ -221,6 +471,15 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * SYMBOLS_AS_DICTIONARY (long) - Flag indicating whether to write the utf8
+   * and large_utf8 fields whose data is a symbol list as dictionary(utf8,
+   * int32) arrays.  Default 0
+   *
    * @param arrow_file  String name of the arrow file to write
    * @param schema_id   The schema identifier
    * @param array_data  Mixed list of arrow array data to be written to the file
@@ -254,6 +513,33 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
    * @param arrow_file  String name of the arrow file to read
    * @options           Dictionary of options or generic null (::) to use
    * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
@@ -262,6 +548,59 @@ extern "C"
   */
   EXP K readArrowData(K arrow_file, K options);
 
+  /**
+   * @brief Reads a range of rows from an arrow IPC record batch file.  Record
+   * batches are read in order until the end of the range is reached, only
+   * those overlapping the range are converted and the rows outside the range
+   * are trimmed.  A range extending beyond the end of the file is truncated.
+   *
+   * Supported options:
+   *
+   * USE_MMAP (long) - Flag indicating whether the arrow file should be memory
+   * mapped in.  This makes reading the batches preceding the range zero copy.
+   * Default 0
+   *
+   * DECIMAL128_AS_DOUBLE (long) - Flag indicating whether to override the
+   * default type mapping for the arrow decimal128 datatype and instead
+   * represent it as a double (9h).  Default 0.
+   *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
+   * @param arrow_file  String name of the arrow file to read
+   * @param start       Index of the first row to read (-7h)
+   * @param num_rows    Maximum number of rows to read (-7h)
+   * @options           Dictionary of options or generic null (::) to use
+   * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
+   * mixed list of -7|-11|4h.
+   * @return            Mixed list of arrow array objects
+  */
+  EXP K readArrowRows(K arrow_file, K start, K num_rows, K options);
+
   /**
    * @brief Serializes to an arrow IPC record batch stream using the specified
    * arrow schema and populated with a mixed list of arrow array objects.
@@ -282,6 +621,15 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * SYMBOLS_AS_DICTIONARY (long) - Flag indicating whether to write the utf8
+   * and large_utf8 fields whose data is a symbol list as dictionary(utf8,
+   * int32) arrays.  Default 0
+   *
    * @param schema_id   The schema identifier
    * @param array_data  Mixed list of arrow array data to be serialized
    * @options           Dictionary of options or generic null (::) to use
@@ -310,6 +658,33 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
    * @param char_array  KG list containing the serialized stream data
    * @options           Dictionary of options or generic null (::) to use
    * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
@@ -329,6 +704,33 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
+   * MULTITHREADED_CONVERSION (long) - Flag indicating whether to convert the
+   * arrow data to kdb using one thread per CPU core.  Only columns mapping to
+   * simple kdb lists are converted in parallel.  Default 0
+   *
+   * STRINGS_AS_SYMBOLS (long) - Flag indicating whether to override the
+   * default type mapping for the arrow utf8 and large_utf8 datatypes, and
+   * dictionaries of them, and instead represent them as a symbol (11h).
+   * Default 0
+   *
+   * STRINGS_AS_FLAT (long) - Flag indicating whether to read each utf8 and
+   * large_utf8 column as a two item list of a single char list (10h) holding
+   * all the strings, and a long list (7h) of length+1 offsets into it.
+   * Ignored for columns read as symbols.  Default 0
+   *
+   * LIST_AS_FLAT (long) - Flag indicating whether to read each list,
+   * large_list and fixed_size_list column whose child values map to a simple
+   * kdb list as a two item list of a single list holding all the child values,
+   * and a long list (7h) of length+1 offsets into it.  Default 0
+   *
+   * COLUMNS (symbol list) - Names of the top level fields to read, in the
+   * order they should be returned.  Only these columns are decoded.
+   *
    * @param orc_file      String name of the ORC file to read
    * @options             Dictionary of options or generic null (::) to use
    * defaults.  Dictionary key must be a 11h list. Values list can be 7h, 11h or
@@ -371,6 +773,11 @@ extern "C"
    * default type mapping for the arrow decimal128 datatype and instead
    * represent it as a double (9h).  Default 0.
    *
+   * DECIMAL128_AS_SCALED_LONG (long) - Flag indicating whether to represent
+   * decimal128 datatypes with a precision of 18 or less as a long (7h) of
+   * their unscaled values, e.g. 12.34 in decimal128(18,2) as 1234.  Takes
+   * precedence over DECIMAL128_AS_DOUBLE.  Default 0.
+   *
    * ORC_CHUNK_SIZE (long) - ORC stripe size, to control the approximate size of
    * data within a column stripe. This currently defaults to 1MB.
    *
@@ -0,0 +1,66 @@
+// decimal_scaled_long.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create the schema and data ||----------+\n";
+N:1000
+dec_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`price;.arrowkdb.dt.decimal128[18i;8i]];
+  .arrowkdb.fd.field[`qty;.arrowkdb.dt.decimal128[10i;0i]]);
+price_data:(N?2000000000000)-1000000000000;
+qty_data:(N?2000000)-1000000;
+dec_data:(price_data;qty_data);
+long_opts:(``DECIMAL128_AS_SCALED_LONG)!(::;1);
+double_opts:(``DECIMAL128_AS_DOUBLE)!(::;1);
+
+-1"\n+----------|| Unscaled longs round trip ||----------+\n";
+parquet_dec:"decimal_scaled_long.parquet";
+.arrowkdb.pq.writeParquet[parquet_dec;dec_schema;dec_data;long_opts];
+dec_data~.arrowkdb.pq.readParquetData[parquet_dec;long_opts]
+
+-1"\n+----------|| Doubles are the scaled values ||----------+\n";
+dec_doubles:.arrowkdb.pq.readParquetData[parquet_dec;double_opts];
+(price_data%1e8)~dec_doubles 0
+(`float$qty_data)~dec_doubles 1
+rm parquet_dec;
+
+-1"\n+----------|| Doubles are rounded to the scale ||----------+\n";
+serialized_dec:.arrowkdb.ipc.serializeArrow[dec_schema;(1.234567891 -0.000000044 100.5;1.4 -2.6 7f);double_opts];
+(123456789 -4 10050000000;1 -3 7)~.arrowkdb.ipc.parseArrowData[serialized_dec;long_opts]
+
+-1"\n+----------|| Large precisions fall back to bytes or doubles ||----------+\n";
+wide_schema:.arrowkdb.sc.schema enlist .arrowkdb.fd.field[`wide;.arrowkdb.dt.decimal128[38i;2i]];
+serialized_dec:.arrowkdb.ipc.serializeArrow[wide_schema;enlist 1.25 -3.5;double_opts];
+(enlist 1.25 -3.5)~.arrowkdb.ipc.parseArrowData[serialized_dec;long_opts,double_opts]
+0h~type first .arrowkdb.ipc.parseArrowData[serialized_dec;long_opts]
+
+-1"\n+----------|| The kdb type must match the options ||----------+\n";
+@[.arrowkdb.ipc.serializeArrow[dec_schema;;::];dec_data;{x}] like "Invalid array, datatype: *, expected: 0, received: 7"
+@[.arrowkdb.ipc.serializeArrow[dec_schema;;double_opts];dec_data;{x}] like "Invalid array, datatype: *, expected: 9, received: 7"
+@[.arrowkdb.ipc.serializeArrow[wide_schema;;long_opts];enlist 1.25 -3.5;{x}] like "Invalid array, datatype: *, expected: 0, received: 9"
+
+-1"\n+----------|| Unscaled longs must fit the precision ||----------+\n";
+@[.arrowkdb.ipc.serializeArrow[dec_schema;;long_opts];(price_data;10000000000,1_qty_data);{x}]~"Invalid value, datatype: 'decimal128(10, 0)', 10000000000 exceeds the precision"
+@[.arrowkdb.ipc.serializeArrow[dec_schema;;long_opts];(price_data;-10000000000,1_qty_data);{x}]~"Invalid value, datatype: 'decimal128(10, 0)', -10000000000 exceeds the precision"
+(9999999999 -9999999999)~last .arrowkdb.ipc.parseArrowData[.arrowkdb.ipc.serializeArrow[dec_schema;(2#price_data;9999999999 -9999999999);long_opts];long_opts]
+
+-1"\n+----------|| Null mapping uses the long null ||----------+\n";
+null_opts:long_opts,(enlist`NULL_MAPPING)!enlist (enlist`decimal)!enlist 0n;
+null_data:dec_data;
+null_data[0;0 1 500]:0N;
+serialized_dec:.arrowkdb.ipc.serializeArrow[dec_schema;null_data;null_opts];
+null_data~.arrowkdb.ipc.parseArrowData[serialized_dec;null_opts]
+(0 1 500)~where first last .arrowkdb.ipc.parseArrowData[serialized_dec;null_opts,(enlist`WITH_NULL_BITMAP)!enlist 1]
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+show .arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
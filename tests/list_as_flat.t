@@ -0,0 +1,58 @@
+// list_as_flat.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create the schema and data ||----------+\n";
+N:1000
+flat_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`id;.arrowkdb.dt.int64[]];
+  .arrowkdb.fd.field[`bids;.arrowkdb.dt.list[.arrowkdb.dt.float64[]]];
+  .arrowkdb.fd.field[`sizes;.arrowkdb.dt.large_list[.arrowkdb.dt.int32[]]];
+  .arrowkdb.fd.field[`levels;.arrowkdb.dt.fixed_size_list[.arrowkdb.dt.int64[];20i]];
+  .arrowkdb.fd.field[`names;.arrowkdb.dt.list[.arrowkdb.dt.utf8[]]]);
+bids_data:{x?100f}each N?20;
+bids_data[10 11]:enlist 0#0f;
+sizes_data:{x?100i}each N?20;
+levels_data:{20?100}each til N;
+names_data:{string x?`a`b`c}each 1+N?5;
+flat_data:(til N;bids_data;sizes_data;levels_data;names_data);
+unflatten:{[flat] (-1_flat 1)_flat 0};
+
+-1"\n+----------|| List columns are read as values and offsets ||----------+\n";
+parquet_flat:"list_as_flat.parquet";
+.arrowkdb.pq.writeParquet[parquet_flat;flat_schema;flat_data;::];
+flat_opts:(``LIST_AS_FLAT)!(::;1);
+flat_read:.arrowkdb.pq.readParquetData[parquet_flat;flat_opts];
+(flat_data 0)~flat_read 0
+(9h;7h)~type each flat_read 1
+(N+1)~count flat_read[1;1]
+bids_data~unflatten flat_read 1
+sizes_data~unflatten flat_read 2
+levels_data~unflatten flat_read 3
+(20*til N+1)~flat_read[3;1]
+sizes_data~unflatten .arrowkdb.pq.readParquetColumn[parquet_flat;2i;flat_opts]
+
+-1"\n+----------|| Lists of mixed lists are not flattened ||----------+\n";
+names_data~flat_read 4
+(`$names_data)~unflatten .arrowkdb.pq.readParquetData[parquet_flat;flat_opts,(enlist`STRINGS_AS_SYMBOLS)!enlist 1] 4
+rm parquet_flat;
+
+-1"\n+----------|| Chunks are joined into one flat column ||----------+\n";
+serialized_flat:.arrowkdb.ipc.serializeArrow[flat_schema;flat_data;(``ARROW_CHUNK_ROWS)!(::;301)];
+flat_read:.arrowkdb.ipc.parseArrowData[serialized_flat;flat_opts];
+bids_data~unflatten flat_read 1
+sizes_data~unflatten flat_read 2
+levels_data~unflatten flat_read 3
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+show .arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
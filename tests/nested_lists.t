@@ -0,0 +1,68 @@
+// nested_lists.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Support null mapping ||----------+\n";
+nested_opts:(`int64`float64`utf8)!(0N;0n;"");
+
+options:(``NULL_MAPPING)!((::);nested_opts);
+
+N:200
+
+-1"\n+----------|| Create the schema ||----------+\n";
+nested_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`longs;.arrowkdb.dt.list[.arrowkdb.dt.int64[]]];
+  .arrowkdb.fd.field[`strings;.arrowkdb.dt.large_list[.arrowkdb.dt.utf8[]]];
+  .arrowkdb.fd.field[`nested;.arrowkdb.dt.list[.arrowkdb.dt.list[.arrowkdb.dt.int64[]]]];
+  .arrowkdb.fd.field[`map;.arrowkdb.dt.map[.arrowkdb.dt.int64[];.arrowkdb.dt.float64[]]]);
+
+-1"\n+----------|| Create data with empty rows and null child values ||----------+\n";
+empty:3 63 64 65 130,N-1;
+longs_data:{x?100}each 1+N?5;
+longs_data[empty]:count[empty]#enlist 0#0;
+longs_data[10 64 66]:(1 0N 3;0#0;0N 0N);
+strings_data:{string x?`a`bb`ccc}each 1+N?4;
+strings_data[empty]:count[empty]#enlist ();
+strings_data[11 67]:(("a";"";"ccc");enlist "");
+nested_data:N#enlist(1 2;0#0;enlist 3);
+nested_data[empty]:count[empty]#enlist ();
+nested_data[12 68]:(enlist 0#0;(0N 4;0#0));
+map_data:{(x?100)!x?100f}each 1+N?3;
+map_data[empty]:count[empty]#enlist (0#0)!0#0f;
+map_data[13 69]:((1 2)!(0n;2f);(enlist 5)!enlist 0n);
+nested_data_all:(longs_data;strings_data;nested_data;map_data);
+
+-1"\n+----------|| Round trip the nested columns ||----------+\n";
+serialized_nested:.arrowkdb.ipc.serializeArrow[nested_schema;nested_data_all;options];
+nested_data_all~.arrowkdb.ipc.parseArrowData[serialized_nested;options]
+
+-1"\n+----------|| Null child values are reported in each row's bitmap ||----------+\n";
+nested_nulls:last .arrowkdb.ipc.parseArrowData[serialized_nested;options,(enlist`WITH_NULL_BITMAP)!enlist 1];
+(null longs_data)~nested_nulls 0
+({"b"$0=count each x}each strings_data)~nested_nulls 1
+({(null key x)!null value x}each map_data)~nested_nulls 3
+
+-1"\n+----------|| Chunks are joined into one column ||----------+\n";
+chunk_options:options,(enlist`ARROW_CHUNK_ROWS)!enlist 64;
+serialized_nested:.arrowkdb.ipc.serializeArrow[nested_schema;nested_data_all;chunk_options];
+nested_data_all~.arrowkdb.ipc.parseArrowData[serialized_nested;options]
+
+-1"\n+----------|| Sliced list arrays start part way through their children ||----------+\n";
+nested_arrow:"nested_lists.arrow";
+.arrowkdb.ipc.writeArrow[nested_arrow;nested_schema;nested_data_all;chunk_options];
+nested_rows:37+til 100;
+(nested_data_all@\:nested_rows)~.arrowkdb.ipc.readArrowRows[nested_arrow;37;100;options]
+rm nested_arrow;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+show .arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,59 @@
+// null_mapping_chunked.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Support null mapping ||----------+\n";
+chunked_opts:(`bool`uint8`int16`int32`int64`float64)!(0b;0x01;2h;3i;4;0n);
+
+options:(``NULL_MAPPING)!((::);chunked_opts);
+
+N:1000
+
+-1"\n+----------|| Create the schema ||----------+\n";
+chunked_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`bool;.arrowkdb.dt.boolean[]];
+  .arrowkdb.fd.field[`uint8;.arrowkdb.dt.uint8[]];
+  .arrowkdb.fd.field[`int16;.arrowkdb.dt.int16[]];
+  .arrowkdb.fd.field[`int32;.arrowkdb.dt.int32[]];
+  .arrowkdb.fd.field[`int64;.arrowkdb.dt.int64[]];
+  .arrowkdb.fd.field[`float64;.arrowkdb.dt.float64[]]);
+
+-1"\n+----------|| Create data with sparse nulls and a run of nulls ||----------+\n";
+sparse:0 63 64 250,N-1;
+run:200+til 128;
+bool_data:N#1b;
+bool_data[sparse,run]:0b;
+ui8_data:0x02+N?0x64;
+ui8_data[sparse,run]:0x01;
+i16_data:5h+N?100h;
+i16_data[sparse,run]:2h;
+i32_data:5i+N?100i;
+i32_data[sparse,run]:3i;
+i64_data:5+N?100;
+i64_data[sparse,run]:4;
+f64_data:N?100f;
+f64_data[sparse,run]:0n;
+chunked_data:(bool_data;ui8_data;i16_data;i32_data;i64_data;f64_data);
+
+-1"\n+----------|| Each array chunk is written to its own position ||----------+\n";
+chunk_options:options,(enlist`ARROW_CHUNK_ROWS)!enlist 301;
+serialized_chunked:.arrowkdb.ipc.serializeArrow[chunked_schema;chunked_data;chunk_options];
+chunked_data~.arrowkdb.ipc.parseArrowData[serialized_chunked;options]
+
+-1"\n+----------|| Nulls are reported at the mapped positions ||----------+\n";
+chunked_nulls:last .arrowkdb.ipc.parseArrowData[serialized_chunked;options,(enlist`WITH_NULL_BITMAP)!enlist 1];
+all{x~(til N)in sparse,run}each chunked_nulls
+
+-1"\n+----------|| Without null mapping the values are read unchanged ||----------+\n";
+serialized_chunked:.arrowkdb.ipc.serializeArrow[chunked_schema;chunked_data;(``ARROW_CHUNK_ROWS)!(::;301)];
+chunked_data~.arrowkdb.ipc.parseArrowData[serialized_chunked;options]
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+show .arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,72 @@
+// null_mapping_temporal.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Support null mapping ||----------+\n";
+temporal_opts:(`date32`date64`timestamp`time32`time64`duration)!(0Nd;0Np;0Np;0Nt;0Nn;0Nn);
+
+options:(``NULL_MAPPING)!((::);temporal_opts);
+
+N:1000
+
+-1"\n+----------|| Create the schema ||----------+\n";
+temporal_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`date32;.arrowkdb.dt.date32[]];
+  .arrowkdb.fd.field[`date64;.arrowkdb.dt.date64[]];
+  .arrowkdb.fd.field[`timestamp;.arrowkdb.dt.timestamp[`milli]];
+  .arrowkdb.fd.field[`time32;.arrowkdb.dt.time32[`milli]];
+  .arrowkdb.fd.field[`time64;.arrowkdb.dt.time64[`nano]];
+  .arrowkdb.fd.field[`duration;.arrowkdb.dt.duration[`milli]]);
+
+-1"\n+----------|| Create data with nulls either side of the 64 bit word boundaries ||----------+\n";
+sparse:0 63 64 127 128 191 250,N-1;
+run:300+til 130;
+d32_data:2020.01.01+til N;
+d32_data[sparse,run]:0Nd;
+d64_data:2020.01.01D+1D*til N;
+d64_data[sparse,run]:0Np;
+ts_data:2024.01.02D+0D00:00:00.001*til N;
+ts_data[sparse,run]:0Np;
+t32_data:00:00:00.001*til N;
+t32_data[sparse,run]:0Nt;
+t64_data:0D00:00:01*til N;
+t64_data[sparse,run]:0Nn;
+dur_data:0D00:00:00.001*til N;
+dur_data[sparse,run]:0Nn;
+temporal_data:(d32_data;d64_data;ts_data;t32_data;t64_data;dur_data);
+
+-1"\n+----------|| Each array chunk is converted with its own validity ||----------+\n";
+chunk_options:options,(enlist`ARROW_CHUNK_ROWS)!enlist 301;
+serialized_temporal:.arrowkdb.ipc.serializeArrow[temporal_schema;temporal_data;chunk_options];
+temporal_data~.arrowkdb.ipc.parseArrowData[serialized_temporal;options]
+
+-1"\n+----------|| Nulls are reported at the mapped positions ||----------+\n";
+temporal_nulls:last .arrowkdb.ipc.parseArrowData[serialized_temporal;options,(enlist`WITH_NULL_BITMAP)!enlist 1];
+all{x~(til N)in sparse,run}each temporal_nulls
+
+-1"\n+----------|| Unchunked ||----------+\n";
+serialized_temporal:.arrowkdb.ipc.serializeArrow[temporal_schema;temporal_data;options];
+temporal_data~.arrowkdb.ipc.parseArrowData[serialized_temporal;options]
+all{x~(til N)in sparse,run}each last .arrowkdb.ipc.parseArrowData[serialized_temporal;options,(enlist`WITH_NULL_BITMAP)!enlist 1]
+
+-1"\n+----------|| Sliced arrays are read from an unaligned bitmap offset ||----------+\n";
+temporal_arrow:"null_mapping_temporal.arrow";
+.arrowkdb.ipc.writeArrow[temporal_arrow;temporal_schema;temporal_data;chunk_options];
+temporal_rows:37+til 400;
+(temporal_data@\:temporal_rows)~.arrowkdb.ipc.readArrowRows[temporal_arrow;37;400;options]
+temporal_nulls:last .arrowkdb.ipc.readArrowRows[temporal_arrow;37;400;options,(enlist`WITH_NULL_BITMAP)!enlist 1];
+all{x~temporal_rows in sparse,run}each temporal_nulls
+rm temporal_arrow;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+show .arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
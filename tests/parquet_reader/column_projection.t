@@ -0,0 +1,57 @@
+// column_projection.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:100
+proj_table:([] id:til N; price:`float$til N; name:N#("aa";"bb"); flag:N#01b; tstamp:2024.01.02D00:00:00+0D00:01*til N);
+proj_options:(``COLUMNS)!(::;`tstamp`id);
+
+-1"\n+----------|| Parquet file ||----------+\n";
+proj_parquet:"column_projection.parquet";
+.arrowkdb.pq.writeParquetFromTable[proj_parquet;proj_table;(``PARQUET_CHUNK_SIZE)!(::;10)];
+(`tstamp`id#proj_table)~.arrowkdb.pq.readParquetToTable[proj_parquet;proj_options]
+(proj_table`price`name)~.arrowkdb.pq.readParquetData[proj_parquet;(``COLUMNS)!(::;`price`name)]
+(enlist proj_table`flag)~.arrowkdb.pq.readParquetData[proj_parquet;(``COLUMNS)!(::;`flag)]
+(10#20_`tstamp`id#proj_table)~.arrowkdb.pq.readParquetRowGroupsToTable[proj_parquet;enlist 2i;::;proj_options]
+(`id`tstamp#10#proj_table)~.arrowkdb.pq.readParquetToTable[proj_parquet;(``COLUMNS`FILTER)!(::;`id`tstamp;(`$"<";`id;5))]
+
+-1"\n+----------|| Parquet streaming reader ||----------+\n";
+reader:.arrowkdb.pq.openParquetReader[proj_parquet;proj_options];
+batches:();
+while[count batch:.arrowkdb.pq.readNextBatch[reader];batches,:enlist flip `tstamp`id!batch];
+(`tstamp`id#proj_table)~raze batches
+.arrowkdb.pq.closeReader[reader];
+
+-1"\n+----------|| Invalid column selections ||----------+\n";
+@[.arrowkdb.pq.readParquetData[proj_parquet;];(``COLUMNS)!(::;`missing);{x}]~"COLUMNS field 'missing' not found"
+@[.arrowkdb.pq.readParquetData[proj_parquet;];(``COLUMNS)!(::;`id`id);{x}]~"COLUMNS field 'id' repeated"
+@[.arrowkdb.pq.readParquetRowGroups[proj_parquet;::;0 1i;];proj_options;{x}]~"columns and COLUMNS option both specified"
+
+rm proj_parquet;
+
+-1"\n+----------|| Arrow file ||----------+\n";
+proj_arrow:"column_projection.arrow";
+.arrowkdb.ipc.writeArrowFromTable[proj_arrow;proj_table;(``ARROW_CHUNK_ROWS)!(::;10)];
+(`tstamp`id#proj_table)~.arrowkdb.ipc.readArrowToTable[proj_arrow;proj_options]
+(proj_table`price`name)~.arrowkdb.ipc.readArrowData[proj_arrow;(``COLUMNS)!(::;`price`name)]
+
+rm proj_arrow;
+
+-1"\n+----------|| Arrow stream ||----------+\n";
+proj_serialized:.arrowkdb.ipc.serializeArrowFromTable[proj_table;::];
+(`tstamp`id#proj_table)~.arrowkdb.ipc.parseArrowToTable[proj_serialized;proj_options]
+(proj_table`price`name)~.arrowkdb.ipc.parseArrowData[proj_serialized;(``COLUMNS)!(::;`price`name)]
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,67 @@
+// parquet_batch_reader.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table and write it with several row groups ||----------+\n";
+N:1000
+batch_table:([] id:til N; price:N?100f; name:string N?`3);
+
+batch_file:"parquet_batch_reader.parquet";
+.arrowkdb.pq.writeParquetFromTable[batch_file;batch_table;(``PARQUET_CHUNK_SIZE)!(::;100)];
+
+-1"\n+----------|| Read the file back one batch at a time ||----------+\n";
+batch_fields:.arrowkdb.fd.fieldName each .arrowkdb.sc.schemaFields[.arrowkdb.pq.readParquetSchema[batch_file]];
+reader:.arrowkdb.pq.openParquetReader[batch_file;::];
+batches:();
+while[count batch:.arrowkdb.pq.readNextBatch[reader];batches,:enlist flip batch_fields!batch];
+0<count batches
+batch_table~raze batches
+
+-1"\n+----------|| Reading past the end keeps returning an empty list ||----------+\n";
+()~.arrowkdb.pq.readNextBatch[reader]
+.arrowkdb.pq.closeReader[reader];
+
+-1"\n+----------|| Closed readers are no longer valid ||----------+\n";
+@[.arrowkdb.pq.readNextBatch;reader;{x}]~"unknown reader"
+@[.arrowkdb.pq.closeReader;reader;{x}]~"unknown reader"
+
+-1"\n+----------|| Batches returned with the null bitmap ||----------+\n";
+reader:.arrowkdb.pq.openParquetReader[batch_file;(``WITH_NULL_BITMAP)!(::;1)];
+batch:.arrowkdb.pq.readNextBatch[reader];
+2~count batch
+((count first first batch)#batch_table)~flip batch_fields!first batch
+all not raze over last batch
+.arrowkdb.pq.closeReader[reader];
+
+-1"\n+----------|| Only row groups which may match the filter are read ||----------+\n";
+reader:.arrowkdb.pq.openParquetReader[batch_file;(``FILTER)!(::;(`within;`id;250 349))];
+batches:();
+while[count batch:.arrowkdb.pq.readNextBatch[reader];batches,:enlist flip batch_fields!batch];
+(200#200_batch_table)~raze batches
+.arrowkdb.pq.closeReader[reader];
+
+-1"\n+----------|| Batch size and I/O options ||----------+\n";
+io_options:(``PARQUET_BATCH_SIZE`PARQUET_PRE_BUFFER`PARQUET_CACHE_HOLE_SIZE_LIMIT`PARQUET_CACHE_RANGE_SIZE_LIMIT)!(::;30;1;1024;1048576);
+reader:.arrowkdb.pq.openParquetReader[batch_file;io_options];
+batches:();
+while[count batch:.arrowkdb.pq.readNextBatch[reader];batches,:enlist flip batch_fields!batch];
+all 30>=count each batches
+batch_table~raze batches
+.arrowkdb.pq.closeReader[reader];
+batch_table~.arrowkdb.pq.readParquetToTable[batch_file;io_options]
+batch_table~.arrowkdb.pq.readParquetToTable[batch_file;(``PARQUET_BUFFERED_STREAM`PARQUET_BUFFER_SIZE)!(::;1;4096)]
+
+rm batch_file;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,45 @@
+// parquet_batch_writer.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:1000
+writer_table:([] id:til N; price:N?100f; name:string N?`3; tstamp:2024.01.02D00:00:00+0D00:00:01*til N);
+writer_schema:.arrowkdb.sc.inferSchema[writer_table];
+
+-1"\n+----------|| Write the table one row group at a time ||----------+\n";
+writer_file:"parquet_batch_writer.parquet";
+writer:.arrowkdb.pq.openParquetWriter[writer_file;writer_schema;(``PARQUET_VERSION)!(::;`V2.0)];
+.arrowkdb.pq.writeRowGroup[writer;value flip 400#writer_table];
+.arrowkdb.pq.writeRowGroupFromTable[writer;400_writer_table];
+.arrowkdb.pq.writeRowGroupFromTable[writer;0#writer_table];
+.arrowkdb.pq.closeWriter[writer];
+
+3i~.arrowkdb.pq.readParquetNumRowGroups[writer_file]
+writer_table~.arrowkdb.pq.readParquetToTable[writer_file;::]
+(400_writer_table)~.arrowkdb.pq.readParquetRowGroupsToTable[writer_file;enlist 1i;::;::]
+
+-1"\n+----------|| Closed writers are no longer valid ||----------+\n";
+.[.arrowkdb.pq.writeRowGroup;(writer;value flip writer_table);{x}]~"unknown writer"
+@[.arrowkdb.pq.closeWriter;writer;{x}]~"unknown writer"
+
+-1"\n+----------|| Invalid row groups ||----------+\n";
+writer:.arrowkdb.pq.openParquetWriter[writer_file;writer_schema;::];
+.[.arrowkdb.pq.writeRowGroup;(writer;2#value flip writer_table);{x}]~"array_data length less than number of schema fields"
+.[.arrowkdb.pq.writeRowGroup;(writer;1 2 3);{x}]~"array_data not mixed list"
+.arrowkdb.pq.closeWriter[writer];
+
+rm writer_file;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
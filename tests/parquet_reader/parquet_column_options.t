@@ -0,0 +1,63 @@
+// parquet_column_options.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:1000
+co_table:([] id:til N; price:N?100f; tstamp:2024.01.02D00:00:00+0D00:00:01*til N; name:N?("aa";"bb"));
+co_parquet:"parquet_column_options.parquet";
+co_v8:8000000<=.arrowkdb.util.buildInfo[]`version;
+
+-1"\n+----------|| Per field encoding and compression ||----------+\n";
+co_columns:`price`tstamp!(`ENCODING`DICTIONARY`COMPRESSION!(`BYTE_STREAM_SPLIT;0;`GZIP);`ENCODING`DICTIONARY!(`DELTA_BINARY_PACKED;0b));
+co_options:``PARQUET_VERSION`COMPRESSION`PARQUET_MAX_ROW_GROUP_LENGTH`PARQUET_COLUMN_OPTIONS!(::;`V2.6;`SNAPPY;100;co_columns);
+$[co_v8;.arrowkdb.pq.writeParquetFromTable[co_parquet;co_table;co_options];1b];
+$[co_v8;co_table~.arrowkdb.pq.readParquetToTable[co_parquet;::];1b]
+$[co_v8;10i~.arrowkdb.pq.readParquetNumRowGroups[co_parquet];1b]
+co_stats:$[co_v8;.arrowkdb.pq.readParquetStatistics[co_parquet];()];
+$[co_v8;all `BYTE_STREAM_SPLIT in/:exec encodings from co_stats where column=`price;1b]
+$[co_v8;all `DELTA_BINARY_PACKED in/:exec encodings from co_stats where column=`tstamp;1b]
+$[co_v8;not any `RLE_DICTIONARY`PLAIN_DICTIONARY in raze exec encodings from co_stats where column=`tstamp;1b]
+$[co_v8;all `gzip=exec codec from co_stats where column=`price;1b]
+$[co_v8;all `snappy=exec codec from co_stats where column in `id`tstamp`name;1b]
+
+-1"\n+----------|| Settings dictionaries with the same keys ||----------+\n";
+co_columns:`id`price!2#enlist `COMPRESSION`COMPRESSION_LEVEL!(`GZIP;9);
+.arrowkdb.pq.writeParquetFromTable[co_parquet;co_table;(``PARQUET_COLUMN_OPTIONS)!(::;co_columns)];
+co_table~.arrowkdb.pq.readParquetToTable[co_parquet;::]
+co_stats:.arrowkdb.pq.readParquetStatistics[co_parquet];
+all `gzip=exec codec from co_stats where column in `id`price
+all `uncompressed=exec codec from co_stats where column in `tstamp`name
+
+-1"\n+----------|| Nested fields apply to their leaf columns ||----------+\n";
+nested_table:([] id:til 100; vals:100#enlist 1.5 2.5 3.5);
+.arrowkdb.pq.writeParquetFromTable[co_parquet;nested_table;(``PARQUET_COLUMN_OPTIONS)!(::;(enlist`vals)!enlist(enlist`COMPRESSION)!enlist`GZIP)];
+nested_table~.arrowkdb.pq.readParquetToTable[co_parquet;::]
+co_stats:.arrowkdb.pq.readParquetStatistics[co_parquet];
+nested_leaf:first exec column from co_stats where column like "vals.*";
+all `gzip=exec codec from co_stats where column=nested_leaf
+all `uncompressed=exec codec from co_stats where column=`id
+.arrowkdb.pq.writeParquetFromTable[co_parquet;nested_table;(``PARQUET_COLUMN_OPTIONS)!(::;(enlist nested_leaf)!enlist(enlist`COMPRESSION)!enlist`GZIP)];
+co_stats:.arrowkdb.pq.readParquetStatistics[co_parquet];
+all `gzip=exec codec from co_stats where column=nested_leaf
+@[.arrowkdb.pq.writeParquetFromTable[co_parquet;nested_table;];(``PARQUET_COLUMN_OPTIONS)!(::;(enlist`vals.missing)!enlist(enlist`DICTIONARY)!enlist 0);{x}]~"PARQUET_COLUMN_OPTIONS field 'vals.missing' not found"
+
+-1"\n+----------|| Invalid settings ||----------+\n";
+@[.arrowkdb.pq.writeParquetFromTable[co_parquet;co_table;];(``PARQUET_COLUMN_OPTIONS)!(::;(enlist`missing)!enlist(enlist`DICTIONARY)!enlist 0);{x}]~"PARQUET_COLUMN_OPTIONS field 'missing' not found"
+@[.arrowkdb.pq.writeParquetFromTable[co_parquet;co_table;];(``PARQUET_COLUMN_OPTIONS)!(::;(enlist`price)!enlist(enlist`ENCODING)!enlist`FOO);{x}]~"Unsupported PARQUET_COLUMN_OPTIONS encoding 'FOO'"
+@[.arrowkdb.pq.writeParquetFromTable[co_parquet;co_table;];(``PARQUET_COLUMN_OPTIONS)!(::;(enlist`price)!enlist(enlist`FOO)!enlist 1);{x}]~"Unsupported PARQUET_COLUMN_OPTIONS setting 'FOO'"
+
+rm co_parquet;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,53 @@
+// parquet_dataset.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+mkdir:{[dirname] $[.z.o like "w*";system "mkdir ",ssr[dirname;"/";"\\"];system "mkdir -p ",dirname]};
+rmdir:{[dirname] $[.z.o like "w*";system "rmdir /s /q ",ssr[dirname;"/";"\\"];system "rm -rf ",dirname]};
+
+-1"\n+----------|| Invalid arguments ||----------+\n";
+.[.arrowkdb.pq.readParquetDataset;(1;::);{x}]~"dataset_dir not 11h or 0 of 10h"
+
+-1"\n+----------|| Create a partitioned dataset ||----------+\n";
+ds_dir:"parquet_dataset";
+ds_table:([] id:til 4; price:1.5 2.5 3.5 4.5; tm:0D00:00:01*til 4);
+ds_parts:((2024.01.02;"A");(2024.01.02;"B");(2024.01.03;"A"));
+ds_paths:{[d;s] ds_dir,"/date=",string[d],"/sym=",s}.' ds_parts;
+mkdir each ds_paths;
+{.arrowkdb.pq.writeParquetFromTable[x,"/part0.parquet";ds_table;::]} each ds_paths;
+.arrowkdb.pq.writeParquetFromTable[ds_dir,"/_ignored.parquet";([] other:1 2 3);::];
+ds_expected:raze {[d;s] update date:d, sym:(count ds_table)#enlist s from ds_table}.' ds_parts;
+ds_sort:{`date`sym`id xasc x};
+
+-1"\n+----------|| Read the dataset ||----------+\n";
+ds_supported:not "arrowkdb built without arrow dataset support"~@[.arrowkdb.pq.readParquetDataset[;::];ds_dir;{x}];
+$[ds_supported;ds_expected~ds_sort .arrowkdb.pq.readParquetDataset[ds_dir;::];1b]
+$[ds_supported;(select from ds_expected where date=2024.01.03)~ds_sort .arrowkdb.pq.readParquetDataset[ds_dir;(``FILTER)!(::;(`$"=";`date;2024.01.03))];1b]
+$[ds_supported;(select from ds_expected where sym~\:"B")~ds_sort .arrowkdb.pq.readParquetDataset[ds_dir;(``FILTER)!(::;(`$"=";`sym;`B))];1b]
+$[ds_supported;(select from ds_expected where tm>=0D00:00:02)~ds_sort .arrowkdb.pq.readParquetDataset[ds_dir;(``FILTER)!(::;(`$">=";`tm;0D00:00:02))];1b]
+$[ds_supported;(select from ds_expected where id within 1 2, date=2024.01.02)~ds_sort .arrowkdb.pq.readParquetDataset[ds_dir;(``FILTER)!(::;((`within;`id;1 2);(`$"<";`date;2024.01.03)))];1b]
+$[ds_supported;(`sym`id xasc select sym, id from ds_expected where date=2024.01.02)~`sym`id xasc .arrowkdb.pq.readParquetDataset[ds_dir;(``COLUMNS`FILTER)!(::;`sym`id;(`$"=";`date;2024.01.02))];1b]
+$[ds_supported;(update `$sym from ds_expected)~ds_sort .arrowkdb.pq.readParquetDataset[ds_dir;(``STRINGS_AS_SYMBOLS)!(::;1)];1b]
+
+rmdir ds_dir;
+
+-1"\n+----------|| Invalid dates and escaped partition values ||----------+\n";
+ds_dir:"parquet_dataset_escaped";
+mkdir ds_dir,"/day=2024-02-30/tag=a%20b";
+.arrowkdb.pq.writeParquetFromTable[ds_dir,"/day=2024-02-30/tag=a%20b/part0.parquet";ds_table;::];
+ds_expected:update day:(count ds_table)#enlist "2024-02-30", tag:(count ds_table)#enlist "a b" from ds_table;
+$[ds_supported;ds_expected~`id xasc .arrowkdb.pq.readParquetDataset[ds_dir;::];1b]
+
+rmdir ds_dir;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
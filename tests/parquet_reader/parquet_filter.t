@@ -0,0 +1,92 @@
+// parquet_filter.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table with sorted columns ||----------+\n";
+N:100
+filter_table:([] id:til N; tstamp:2024.01.02D00:00:00+0D00:01*til N; sym:N#("aa";"bb";"cc";"dd"); price:`float$til N);
+
+-1"\n+----------|| Write the table to a parquet file with ten row groups ||----------+\n";
+filter_file:"parquet_filter.parquet";
+.arrowkdb.pq.writeParquetFromTable[filter_file;filter_table;(``PARQUET_CHUNK_SIZE)!(::;10)];
+10i~.arrowkdb.pq.readParquetNumRowGroups[filter_file]
+
+-1"\n+----------|| Filter with no predicates reads all row groups ||----------+\n";
+filter_table~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;())]
+
+-1"\n+----------|| Filter on comparison operators ||----------+\n";
+(40#filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`$"<";`id;35))]
+(20#filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`le;`id;19))]
+(-30#filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`$">";`id;70))]
+(10#20_filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`$"=";`id;25))]
+(10#20_filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`eq;`price;25f))]
+
+-1"\n+----------|| Filter on within and in ||----------+\n";
+(20#20_filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`within;`id;25 34))]
+(20#30_filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`within;`tstamp;2024.01.02D00:35 2024.01.02D00:45))]
+filter_table[(til 10),50+til 10]~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`in;`id;5 55))]
+
+-1"\n+----------|| Temporal values are checked against the column's type ||----------+\n";
+filter_table~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`$"<";`tstamp;2024.01.03))]
+0~count first .arrowkdb.pq.readParquetData[filter_file;(``FILTER)!(::;(`$"<";`tstamp;2024.01.02))]
+@[.arrowkdb.pq.readParquetData[filter_file;];(``FILTER)!(::;(`$"<";`id;2024.01.03));{x}]~"FILTER value for column 'id' has type -14h but the column is read as 7h"
+@[.arrowkdb.pq.readParquetData[filter_file;];(``FILTER)!(::;(`$"<";`tstamp;00:01:00.000));{x}]~"FILTER value for column 'tstamp' has type -19h but the column is read as 12h"
+
+-1"\n+----------|| Multiple predicates must all be satisfied ||----------+\n";
+(10#30_filter_table)~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;((`$">=";`id;30);(`$"<";`tstamp;2024.01.02D00:40)))]
+
+-1"\n+----------|| Predicates which can't exclude any row group ||----------+\n";
+filter_table~.arrowkdb.pq.readParquetToTable[filter_file;(``FILTER)!(::;(`in;`sym;("aa";"dd")))]
+0~count first .arrowkdb.pq.readParquetData[filter_file;(``FILTER)!(::;(`$">";`id;1000))]
+
+-1"\n+----------|| Filter combined with row group selection ||----------+\n";
+(20#50_filter_table)~.arrowkdb.pq.readParquetRowGroupsToTable[filter_file;4 5 6i;::;(``FILTER)!(::;(`$">=";`id;50))]
+
+rm filter_file;
+
+-1"\n+----------|| Page index row trimming ||----------+\n";
+page_table:([] id:til 10000; price:10000?100f);
+page_file:"parquet_filter_page_index.parquet";
+page_write:@[.arrowkdb.pq.writeParquetFromTable[page_file;page_table;];(``PARQUET_CHUNK_SIZE`PARQUET_DATA_PAGE_SIZE`PARQUET_WRITE_PAGE_INDEX)!(::;10000;1;1);{x}];
+page_v12:12000000<=.arrowkdb.util.buildInfo[]`version;
+if[not page_v12;-1"SKIPPED: page index pruning requires libarrow 12 or later (found ",string[.arrowkdb.util.buildInfo[]`version_string],"), only checking the write is rejected"];
+$[page_v12;page_write~(::);page_write~"PARQUET_WRITE_PAGE_INDEX requires libarrow 12 or later"]
+page_read:$[page_v12;.arrowkdb.pq.readParquetToTable[page_file;(``FILTER)!(::;(`within;`id;5000 5010))];page_table];
+(select from page_table where id within 5000 5010)~select from page_read where id within 5000 5010
+$[page_v12;count[page_read]<count page_table;1b]
+page_read:$[page_v12;.arrowkdb.pq.readParquetRowGroupsToTable[page_file;::;::;(``FILTER)!(::;(`$">=";`id;9990))];page_table];
+(select from page_table where id>=9990)~select from page_read where id>=9990
+$[page_v12;count[page_read]<count page_table;1b]
+page_table:update rid:reverse id from page_table;
+page_write:@[.arrowkdb.pq.writeParquetFromTable[page_file;page_table;];(``PARQUET_CHUNK_SIZE`PARQUET_DATA_PAGE_SIZE`PARQUET_WRITE_PAGE_INDEX)!(::;10000;1;1);{x}];
+page_read:$[page_v12;.arrowkdb.pq.readParquetToTable[page_file;(``FILTER)!(::;((`$"<";`id;10);(`$"<";`rid;10)))];0#page_table];
+0~count page_read
+
+rm page_file;
+
+-1"\n+----------|| Bloom filters for point lookups ||----------+\n";
+bloom_table:([] order_id:{"ORD",string x} each neg[1000]?1000; qty:til 1000);
+bloom_file:"parquet_filter_bloom.parquet";
+bloom_write:@[.arrowkdb.pq.writeParquetFromTable[bloom_file;bloom_table;];(``PARQUET_CHUNK_SIZE`PARQUET_BLOOM_FILTER_COLUMNS)!(::;100;`order_id);{x}];
+bloom_v21:21000000<=.arrowkdb.util.buildInfo[]`version;
+if[not bloom_v21;-1"SKIPPED: bloom filter pruning requires libarrow 21 or later (found ",string[.arrowkdb.util.buildInfo[]`version_string],"), only checking the write is rejected"];
+$[bloom_v21;bloom_write~(::);bloom_write~"PARQUET_BLOOM_FILTER_COLUMNS requires libarrow 21 or later"]
+bloom_read:$[bloom_v21;.arrowkdb.pq.readParquetToTable[bloom_file;(``FILTER)!(::;(`$"=";`order_id;bloom_table[`order_id;420]))];bloom_table];
+$[bloom_v21;(bloom_table 420)~first select from bloom_read where order_id~\:bloom_table[`order_id;420];1b]
+$[bloom_v21;count[bloom_read]<count bloom_table;1b]
+@[.arrowkdb.pq.writeParquetFromTable[bloom_file;bloom_table;];(``PARQUET_BLOOM_FILTER_COLUMNS)!(::;`missing);{x}]~"PARQUET_BLOOM_FILTER_COLUMNS field 'missing' not found"
+
+rm bloom_file;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
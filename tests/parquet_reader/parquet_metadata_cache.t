@@ -0,0 +1,55 @@
+// parquet_metadata_cache.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Write a parquet file with ten row groups ||----------+\n";
+cache_table:([] id:til 100; price:`float$til 100);
+cache_file:"parquet_metadata_cache.parquet";
+.arrowkdb.pq.writeParquetFromTable[cache_file;cache_table;(``PARQUET_CHUNK_SIZE)!(::;10)];
+
+-1"\n+----------|| Repeated reads are served from the cached footer ||----------+\n";
+10i~.arrowkdb.pq.readParquetNumRowGroups[cache_file]
+10i~.arrowkdb.pq.readParquetNumRowGroups[cache_file]
+cache_table~.arrowkdb.pq.readParquetToTable[cache_file;::]
+cache_table~.arrowkdb.pq.readParquetToTable[cache_file;::]
+(10#20_cache_table)~.arrowkdb.pq.readParquetRowGroupsToTable[cache_file;enlist 2i;::;::]
+
+-1"\n+----------|| Rewriting the file invalidates the cached footer ||----------+\n";
+cache_table2:([] id:til 200; price:`float$til 200; sym:200#`a`b);
+.arrowkdb.pq.writeParquetFromTable[cache_file;cache_table2;(``PARQUET_CHUNK_SIZE)!(::;50)];
+4i~.arrowkdb.pq.readParquetNumRowGroups[cache_file]
+(update string sym from cache_table2)~.arrowkdb.pq.readParquetToTable[cache_file;::]
+
+-1"\n+----------|| Replacing the file with one of the same size invalidates the cached footer ||----------+\n";
+// Preserve the mtime on Linux/MacOS so that only the inode and ctime change
+mv:{[src;dst] $[.z.o like "w*";system "move /Y ",src," ",dst;system "touch -r ",dst," ",src," && mv ",src," ",dst]};
+other_table:([] di:til 100; ecirp:`float$til 100);
+other_file:"parquet_metadata_cache_other.parquet";
+.arrowkdb.pq.writeParquetFromTable[cache_file;cache_table;::];
+.arrowkdb.pq.writeParquetFromTable[other_file;other_table;::];
+(hcount hsym `$cache_file)~hcount hsym `$other_file
+cache_table~.arrowkdb.pq.readParquetToTable[cache_file;::]
+mv[other_file;cache_file];
+other_table~.arrowkdb.pq.readParquetToTable[cache_file;::]
+(`di`ecirp)~.arrowkdb.fd.fieldName each .arrowkdb.sc.schemaFields .arrowkdb.pq.readParquetSchema[cache_file]
+.arrowkdb.pq.writeParquetFromTable[cache_file;cache_table2;(``PARQUET_CHUNK_SIZE)!(::;50)];
+
+-1"\n+----------|| Clearing the cache ||----------+\n";
+.arrowkdb.pq.clearParquetMetadataCache[];
+4i~.arrowkdb.pq.readParquetNumRowGroups[cache_file]
+(update string sym from cache_table2)~.arrowkdb.pq.readParquetToTable[cache_file;::]
+
+rm cache_file;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
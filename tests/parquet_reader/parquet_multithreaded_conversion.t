@@ -0,0 +1,43 @@
+// parquet_multithreaded_conversion.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table with simple and nested columns ||----------+\n";
+N:10000
+mt_table:([] id:til N; tstamp:2024.01.02D00:00:00+0D00:00:01*til N; flag:N#01b; price:`float$til N; str:N#("aa";"bb";"cc"));
+mt_options:(``MULTITHREADED_CONVERSION)!(::;1);
+
+-1"\n+----------|| Parquet file with many row groups ||----------+\n";
+mt_parquet:"parquet_multithreaded_conversion.parquet";
+.arrowkdb.pq.writeParquetFromTable[mt_parquet;mt_table;(``PARQUET_CHUNK_SIZE)!(::;1000)];
+mt_table~.arrowkdb.pq.readParquetToTable[mt_parquet;mt_options]
+.arrowkdb.pq.readParquetData[mt_parquet;::]~.arrowkdb.pq.readParquetData[mt_parquet;mt_options]
+(1000#3000_mt_table)~.arrowkdb.pq.readParquetRowGroupsToTable[mt_parquet;enlist 3i;::;mt_options]
+
+-1"\n+----------|| Null bitmap is converted in parallel too ||----------+\n";
+mt_bitmap_options:(``MULTITHREADED_CONVERSION`WITH_NULL_BITMAP)!(::;1;1);
+.arrowkdb.pq.readParquetData[mt_parquet;(``WITH_NULL_BITMAP)!(::;1)]~.arrowkdb.pq.readParquetData[mt_parquet;mt_bitmap_options]
+
+rm mt_parquet;
+
+-1"\n+----------|| Arrow file and stream with many record batches ||----------+\n";
+mt_arrow:"parquet_multithreaded_conversion.arrow";
+.arrowkdb.ipc.writeArrowFromTable[mt_arrow;mt_table;(``ARROW_CHUNK_ROWS)!(::;1000)];
+mt_table~.arrowkdb.ipc.readArrowToTable[mt_arrow;mt_options]
+mt_serialized:.arrowkdb.ipc.serializeArrowFromTable[mt_table;(``ARROW_CHUNK_ROWS)!(::;1000)];
+mt_table~.arrowkdb.ipc.parseArrowToTable[mt_serialized;mt_options]
+
+rm mt_arrow;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
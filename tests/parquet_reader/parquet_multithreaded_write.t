@@ -0,0 +1,62 @@
+// parquet_multithreaded_write.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:10000
+mw_table:([] id:til N; price:N?100f; tstamp:2024.01.02D00:00:00+0D00:00:01*til N; sym:N?`aa`bb`cc; name:N?("aa";"bb"));
+mw_single:"parquet_single_write.parquet";
+mw_multi:"parquet_multithreaded_write.parquet";
+// Symbols are read back as strings
+mw_expected:update string sym from mw_table;
+
+-1"\n+----------|| Multithreaded write matches single threaded write ||----------+\n";
+mw_options:``PARQUET_CHUNK_SIZE`ARROW_CHUNK_ROWS!(::;1000;300);
+.arrowkdb.pq.writeParquetFromTable[mw_single;mw_table;mw_options];
+.arrowkdb.pq.writeParquetFromTable[mw_multi;mw_table;mw_options,(enlist`PARQUET_MULTITHREADED_WRITE)!enlist 1];
+mw_expected~.arrowkdb.pq.readParquetToTable[mw_multi;::]
+mw_expected~.arrowkdb.pq.readParquetToTable[mw_single;::]
+10i~.arrowkdb.pq.readParquetNumRowGroups[mw_multi]
+(delete compressed_size,uncompressed_size from .arrowkdb.pq.readParquetStatistics[mw_single])~delete compressed_size,uncompressed_size from .arrowkdb.pq.readParquetStatistics[mw_multi]
+
+-1"\n+----------|| Thread count ||----------+\n";
+mw_v11:11000000<=.arrowkdb.util.buildInfo[]`version;
+if[not mw_v11;-1"SKIPPED: PARQUET_WRITE_THREADS requires libarrow 11 or later (found ",string[.arrowkdb.util.buildInfo[]`version_string],"), only checking it is rejected"];
+mw_threads:@[.arrowkdb.pq.writeParquetFromTable[mw_multi;mw_table;];``PARQUET_MULTITHREADED_WRITE`PARQUET_WRITE_THREADS!(::;1;2);{x}];
+$[mw_v11;mw_threads~(::);mw_threads~"PARQUET_WRITE_THREADS requires libarrow 11 or later"]
+$[mw_v11;mw_expected~.arrowkdb.pq.readParquetToTable[mw_multi;::];1b]
+$[mw_v11;(::)~.arrowkdb.pq.writeParquetFromTable[mw_single;mw_table;``PARQUET_MULTITHREADED_WRITE`PARQUET_WRITE_THREADS!(::;1;3)];1b]
+$[mw_v11;mw_expected~.arrowkdb.pq.readParquetToTable[mw_single;::];1b]
+@[.arrowkdb.pq.writeParquetFromTable[mw_multi;mw_table;];``PARQUET_MULTITHREADED_WRITE`PARQUET_WRITE_THREADS!(::;1;-1);{x}]~"PARQUET_WRITE_THREADS must be positive"
+@[.arrowkdb.pq.writeParquetFromTable[mw_multi;mw_table;];``PARQUET_MULTITHREADED_WRITE`PARQUET_WRITE_THREADS!(::;1;0);{x}]~"PARQUET_WRITE_THREADS must be positive"
+
+-1"\n+----------|| Incremental writer ||----------+\n";
+mw_writer:.arrowkdb.pq.openParquetWriter[mw_multi;.arrowkdb.sc.inferSchema mw_table;(``PARQUET_MULTITHREADED_WRITE)!(::;1)];
+.arrowkdb.pq.writeRowGroupFromTable[mw_writer;5000#mw_table];
+.arrowkdb.pq.writeRowGroupFromTable[mw_writer;5000_mw_table];
+.arrowkdb.pq.closeWriter[mw_writer];
+mw_expected~.arrowkdb.pq.readParquetToTable[mw_multi;::]
+2i~.arrowkdb.pq.readParquetNumRowGroups[mw_multi]
+mw_writer:$[mw_v11;.arrowkdb.pq.openParquetWriter[mw_single;.arrowkdb.sc.inferSchema mw_table;``PARQUET_MULTITHREADED_WRITE`PARQUET_WRITE_THREADS!(::;1;2)];0Ni];
+if[mw_v11;.arrowkdb.pq.writeRowGroupFromTable[mw_writer;mw_table];.arrowkdb.pq.closeWriter[mw_writer]];
+$[mw_v11;mw_expected~.arrowkdb.pq.readParquetToTable[mw_single;::];1b]
+
+-1"\n+----------|| Conversion errors are returned from the worker threads ||----------+\n";
+mw_schema:.arrowkdb.sc.schema (.arrowkdb.fd.field[`id;.arrowkdb.dt.int64[]];.arrowkdb.fd.field[`price;.arrowkdb.dt.float64[]]);
+@[.arrowkdb.pq.writeParquet[mw_multi;mw_schema;;(``PARQUET_MULTITHREADED_WRITE)!(::;1)];(til 10;til 10);{x}] like "Invalid array*"
+
+rm mw_single;
+rm mw_multi;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,54 @@
+// parquet_statistics.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:10
+stats_table:([] id:til N; price:1.5+til N; name:N#("bb";"aa";"cc"); tstamp:2024.01.02D00:00:00+0D00:01*til N; dt:2024.01.01+til N);
+stats_parquet:"parquet_statistics.parquet";
+.arrowkdb.pq.writeParquetFromTable[stats_parquet;stats_table;(``PARQUET_CHUNK_SIZE)!(::;5)];
+
+-1"\n+----------|| Read the statistics ||----------+\n";
+stats:.arrowkdb.pq.readParquetStatistics[stats_parquet];
+`row_group`column`num_values`null_count`distinct_count`min_value`max_value`compressed_size`uncompressed_size`encodings`codec~cols stats
+(raze 5#/:0 1i)~stats`row_group
+(10#`id`price`name`tstamp`dt)~stats`column
+(10#5)~stats`num_values
+(10#0)~stats`null_count
+(0 5;4 9)~raze each exec (min_value;max_value) from stats where column=`id
+(1.5 6.5;5.5 10.5)~raze each exec (min_value;max_value) from stats where column=`price
+(("aa";"aa");("cc";"cc"))~exec (min_value;max_value) from stats where column=`name
+(first each 5 cut stats_table`tstamp)~raze exec min_value from stats where column=`tstamp
+(last each 5 cut stats_table`dt)~raze exec max_value from stats where column=`dt
+all 11h=type each stats`encodings
+all 0<stats`compressed_size
+
+-1"\n+----------|| Duration statistics are timespans ||----------+\n";
+dur_schema:.arrowkdb.sc.schema[(.arrowkdb.fd.field[`id;.arrowkdb.dt.int64[]];.arrowkdb.fd.field[`dur;.arrowkdb.dt.duration[`MILLI]])];
+dur_data:(til N;0D00:00:01.5*til N);
+dur_parquet:"parquet_statistics_duration.parquet";
+dur_write:.[.arrowkdb.pq.writeParquet;(dur_parquet;dur_schema;dur_data;(``PARQUET_CHUNK_SIZE)!(::;5));{x}];
+dur_read:$[dur_write~(::);.arrowkdb.dt.datatypeName .arrowkdb.fd.fieldDatatype last .arrowkdb.sc.schemaFields .arrowkdb.pq.readParquetSchema dur_parquet;`];
+if[not dur_read~`duration;-1"SKIPPED: this libarrow doesn't round trip duration fields through parquet"];
+dur_stats:$[dur_read~`duration;select from .arrowkdb.pq.readParquetStatistics[dur_parquet] where column=`dur;([] min_value:(); max_value:())];
+$[dur_read~`duration;(first each 5 cut dur_data 1)~dur_stats`min_value;1b]
+$[dur_read~`duration;(last each 5 cut dur_data 1)~dur_stats`max_value;1b]
+if[dur_write~(::);rm dur_parquet];
+
+-1"\n+----------|| Invalid arguments ||----------+\n";
+@[.arrowkdb.pq.readParquetStatistics;1;{x}]~"parquet_file not 11h or 0 of 10h"
+
+rm stats_parquet;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -0,0 +1,49 @@
+// row_range.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:100
+range_table:([] id:til N; price:`float$til N; name:N#("aa";"bb"); tstamp:2024.01.02D00:00:00+0D00:01*til N);
+
+-1"\n+----------|| Parquet file ||----------+\n";
+range_parquet:"row_range.parquet";
+.arrowkdb.pq.writeParquetFromTable[range_parquet;range_table;(``PARQUET_CHUNK_SIZE)!(::;10)];
+(value flip 5#25_range_table)~.arrowkdb.pq.readParquetRows[range_parquet;25;5;::]
+(value flip 30#15_range_table)~.arrowkdb.pq.readParquetRows[range_parquet;15;30;::]
+(10#20_range_table)~.arrowkdb.pq.readParquetRowsToTable[range_parquet;20;10;::]
+(5#95_range_table)~.arrowkdb.pq.readParquetRowsToTable[range_parquet;95;100;::]
+(`tstamp`id#3#42_range_table)~.arrowkdb.pq.readParquetRowsToTable[range_parquet;42;3;(``COLUMNS)!(::;`tstamp`id)]
+0=count .arrowkdb.pq.readParquetRowsToTable[range_parquet;200;10;::]
+0=count .arrowkdb.pq.readParquetRowsToTable[range_parquet;50;0;::]
+
+-1"\n+----------|| Invalid ranges ||----------+\n";
+.[.arrowkdb.pq.readParquetRows[range_parquet;;10;];(5i;::);{x}]~"start not -7h"
+.[.arrowkdb.pq.readParquetRows[range_parquet;5;;];(10i;::);{x}]~"num_rows not -7h"
+.[.arrowkdb.pq.readParquetRows[range_parquet;-1;;];(10;::);{x}]~"negative start or num_rows"
+
+rm range_parquet;
+
+-1"\n+----------|| Arrow file ||----------+\n";
+range_arrow:"row_range.arrow";
+.arrowkdb.ipc.writeArrowFromTable[range_arrow;range_table;(``ARROW_CHUNK_ROWS)!(::;10)];
+(value flip 5#25_range_table)~.arrowkdb.ipc.readArrowRows[range_arrow;25;5;::]
+(30#15_range_table)~.arrowkdb.ipc.readArrowRowsToTable[range_arrow;15;30;::]
+(5#95_range_table)~.arrowkdb.ipc.readArrowRowsToTable[range_arrow;95;100;(``USE_MMAP)!(::;1)]
+(`name`id#3#42_range_table)~.arrowkdb.ipc.readArrowRowsToTable[range_arrow;42;3;(``COLUMNS)!(::;`name`id)]
+0=count .arrowkdb.ipc.readArrowRowsToTable[range_arrow;200;10;::]
+
+rm range_arrow;
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
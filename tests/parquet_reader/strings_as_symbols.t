@@ -0,0 +1,61 @@
+// strings_as_symbols.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:1000
+sym_table:([] id:til N; name:string N?`AAPL`MSFT`IBM`GOOG; venue:N#("XNAS";"XNYS";"BATS"));
+sym_expected:update `$name, `$venue from sym_table;
+sym_options:(``STRINGS_AS_SYMBOLS)!(::;1);
+
+-1"\n+----------|| Parquet file ||----------+\n";
+sym_parquet:"strings_as_symbols.parquet";
+.arrowkdb.pq.writeParquetFromTable[sym_parquet;sym_table;(``PARQUET_CHUNK_SIZE)!(::;100)];
+sym_table~.arrowkdb.pq.readParquetToTable[sym_parquet;::]
+sym_expected~.arrowkdb.pq.readParquetToTable[sym_parquet;sym_options]
+sym_expected~.arrowkdb.pq.readParquetToTable[sym_parquet;sym_options,(``MULTITHREADED_CONVERSION)!(::;1)]
+(sym_expected`name)~.arrowkdb.pq.readParquetColumn[sym_parquet;1i;sym_options]
+(10#200_sym_expected)~.arrowkdb.pq.readParquetRowsToTable[sym_parquet;200;10;sym_options]
+
+-1"\n+----------|| Parquet streaming reader ||----------+\n";
+reader:.arrowkdb.pq.openParquetReader[sym_parquet;sym_options,(``PARQUET_BATCH_SIZE)!(::;300)];
+batches:();
+while[count batch:.arrowkdb.pq.readNextBatch[reader];batches,:enlist flip cols[sym_table]!batch];
+sym_expected~raze batches
+.arrowkdb.pq.closeReader[reader];
+
+rm sym_parquet;
+
+-1"\n+----------|| Null strings ||----------+\n";
+null_schema:.arrowkdb.sc.schema[(.arrowkdb.fd.field[`str;.arrowkdb.dt.utf8[]])];
+null_parquet:"strings_as_symbols_nulls.parquet";
+.arrowkdb.pq.writeParquet[null_parquet;null_schema;enlist ("aa";"";"cc");(``NULL_MAPPING)!(::;(enlist`utf8)!enlist"")];
+(enlist`aa``cc)~.arrowkdb.pq.readParquetData[null_parquet;sym_options]
+(enlist`aa`none`cc)~.arrowkdb.pq.readParquetData[null_parquet;sym_options,(``NULL_MAPPING)!(::;(enlist`utf8)!enlist"none")]
+(enlist 010b)~last .arrowkdb.pq.readParquetData[null_parquet;sym_options,(``WITH_NULL_BITMAP)!(::;1)]
+
+rm null_parquet;
+
+-1"\n+----------|| Arrow file ||----------+\n";
+sym_arrow:"strings_as_symbols.arrow";
+.arrowkdb.ipc.writeArrowFromTable[sym_arrow;sym_table;(``ARROW_CHUNK_ROWS)!(::;100)];
+sym_expected~.arrowkdb.ipc.readArrowToTable[sym_arrow;sym_options]
+
+rm sym_arrow;
+
+-1"\n+----------|| Arrow stream ||----------+\n";
+sym_serialized:.arrowkdb.ipc.serializeArrowFromTable[sym_table;::];
+sym_expected~.arrowkdb.ipc.parseArrowToTable[sym_serialized;sym_options]
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
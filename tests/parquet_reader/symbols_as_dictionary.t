@@ -0,0 +1,65 @@
+// symbols_as_dictionary.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create a table ||----------+\n";
+N:1000
+sd_table:([] id:til N; sym:N?`AAPL`MSFT`IBM`GOOG; venue:N?`XNAS`XNYS`BATS; note:N?("aa";"bb"));
+sd_options:(``SYMBOLS_AS_DICTIONARY)!(::;1);
+sd_read:(``STRINGS_AS_SYMBOLS)!(::;1);
+sd_names:{[schema] .arrowkdb.dt.datatypeName each .arrowkdb.fd.fieldDatatype each .arrowkdb.sc.schemaFields schema};
+
+-1"\n+----------|| Arrow IPC stream ||----------+\n";
+sd_serialized:.arrowkdb.ipc.serializeArrowFromTable[sd_table;sd_options];
+`int64`dictionary`dictionary`utf8~sd_names .arrowkdb.ipc.parseArrowSchema[sd_serialized]
+(update `$note from sd_table)~.arrowkdb.ipc.parseArrowToTable[sd_serialized;sd_read]
+sd_dict:.arrowkdb.ipc.parseArrowData[sd_serialized;::]1;
+(distinct sd_table`sym)~`$first sd_dict
+(sd_table`sym)~(`$first sd_dict)last sd_dict
+
+-1"\n+----------|| Arrow IPC file with chunks sharing a dictionary ||----------+\n";
+sd_arrow:"symbols_as_dictionary.arrow";
+.arrowkdb.ipc.writeArrowFromTable[sd_arrow;sd_table;sd_options,(``ARROW_CHUNK_ROWS)!(::;300)];
+`int64`dictionary`dictionary`utf8~sd_names .arrowkdb.ipc.readArrowSchema[sd_arrow]
+(delete note from sd_table)~delete note from .arrowkdb.ipc.readArrowToTable[sd_arrow;sd_read]
+rm sd_arrow;
+
+-1"\n+----------|| Parquet file ||----------+\n";
+sd_parquet:"symbols_as_dictionary.parquet";
+.arrowkdb.pq.writeParquetFromTable[sd_parquet;sd_table;sd_options,(``PARQUET_CHUNK_SIZE)!(::;100)];
+(update `$note from sd_table)~.arrowkdb.pq.readParquetToTable[sd_parquet;sd_read]
+sd_stats:.arrowkdb.pq.readParquetStatistics[sd_parquet];
+all {any `RLE_DICTIONARY`PLAIN_DICTIONARY in x} each exec encodings from sd_stats where column=`sym
+
+-1"\n+----------|| Incremental parquet writer ||----------+\n";
+sd_writer:.arrowkdb.pq.openParquetWriter[sd_parquet;.arrowkdb.sc.inferSchema sd_table;sd_options];
+.arrowkdb.pq.writeRowGroupFromTable[sd_writer;500#sd_table];
+.arrowkdb.pq.writeRowGroupFromTable[sd_writer;500_sd_table];
+.arrowkdb.pq.closeWriter[sd_writer];
+(update `$note from sd_table)~.arrowkdb.pq.readParquetToTable[sd_parquet;sd_read]
+rm sd_parquet;
+sd_writer:.arrowkdb.pq.openParquetWriter[sd_parquet;.arrowkdb.sc.inferSchema sd_table;sd_options];
+.arrowkdb.pq.writeRowGroupFromTable[sd_writer;500#sd_table];
+@[.arrowkdb.pq.writeRowGroupFromTable[sd_writer;];update string sym from 500_sd_table;{x}]~"SYMBOLS_AS_DICTIONARY field 'sym' in row group 1 is not a symbol list, received: 0h"
+.arrowkdb.pq.closeWriter[sd_writer];
+rm sd_parquet;
+
+-1"\n+----------|| Null mapping ||----------+\n";
+sd_schema:.arrowkdb.sc.schema[(.arrowkdb.fd.field[`sym;.arrowkdb.dt.utf8[]])];
+sd_null:sd_options,(``NULL_MAPPING)!(::;(enlist`utf8)!enlist"none");
+sd_serialized:.arrowkdb.ipc.serializeArrow[sd_schema;enlist`aa`none`cc`none;sd_null];
+(enlist 0101b)~last .arrowkdb.ipc.parseArrowData[sd_serialized;sd_read,(``WITH_NULL_BITMAP)!(::;1)]
+(enlist`aa``cc`)~.arrowkdb.ipc.parseArrowData[sd_serialized;sd_read]
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
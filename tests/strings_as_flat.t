@@ -0,0 +1,62 @@
+// strings_as_flat.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Filesystem functions for Linux/MacOS/Windows ||----------+\n";
+rm:{[filename] $[.z.o like "w*";system "del ",filename;system "rm ",filename]};
+
+-1"\n+----------|| Create the schema and data ||----------+\n";
+N:1000
+flat_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`id;.arrowkdb.dt.int64[]];
+  .arrowkdb.fd.field[`str;.arrowkdb.dt.utf8[]];
+  .arrowkdb.fd.field[`lstr;.arrowkdb.dt.large_utf8[]];
+  .arrowkdb.fd.field[`bin;.arrowkdb.dt.binary[]]);
+str_data:{x?"abcdef"}each N?20;
+str_data[10 11]:enlist"";
+flat_data:(til N;str_data;reverse str_data;`byte$str_data);
+unflatten:{[flat] (-1_flat 1)_flat 0};
+
+-1"\n+----------|| Bulk read of strings and binaries ||----------+\n";
+parquet_flat:"strings_as_flat.parquet";
+.arrowkdb.pq.writeParquet[parquet_flat;flat_schema;flat_data;::];
+flat_data~.arrowkdb.pq.readParquetData[parquet_flat;::]
+
+-1"\n+----------|| String columns are read as chars and offsets ||----------+\n";
+flat_opts:(``STRINGS_AS_FLAT)!(::;1);
+flat_read:.arrowkdb.pq.readParquetData[parquet_flat;flat_opts];
+(flat_data 0)~flat_read 0
+(10h;7h)~type each flat_read 1
+(N+1)~count flat_read[1;1]
+0~first flat_read[1;1]
+str_data~unflatten flat_read 1
+(reverse str_data)~unflatten flat_read 2
+(flat_data 3)~flat_read 3
+str_data~unflatten .arrowkdb.pq.readParquetColumn[parquet_flat;1i;flat_opts]
+rm parquet_flat;
+
+-1"\n+----------|| Chunks are joined into one flat column ||----------+\n";
+serialized_flat:.arrowkdb.ipc.serializeArrow[flat_schema;flat_data;(``ARROW_CHUNK_ROWS)!(::;301)];
+flat_read:.arrowkdb.ipc.parseArrowData[serialized_flat;flat_opts];
+str_data~unflatten flat_read 1
+(reverse str_data)~unflatten flat_read 2
+
+-1"\n+----------|| Null mapping is applied to the flat column ||----------+\n";
+null_opts:(``NULL_MAPPING)!(::;`utf8`large_utf8!("NA";"NA"));
+null_data:flat_data;
+null_data[1;0 500]:enlist"NA";
+serialized_flat:.arrowkdb.ipc.serializeArrow[flat_schema;null_data;null_opts,(enlist`ARROW_CHUNK_ROWS)!enlist 301];
+(null_data 1)~unflatten .arrowkdb.ipc.parseArrowData[serialized_flat;null_opts,flat_opts] 1
+
+-1"\n+----------|| Symbols take precedence ||----------+\n";
+(`$null_data 1)~.arrowkdb.ipc.parseArrowData[serialized_flat;null_opts,flat_opts,(enlist`STRINGS_AS_SYMBOLS)!enlist 1] 1
+
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+show .arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
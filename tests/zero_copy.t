@@ -0,0 +1,55 @@
+// zero_copy.t
+
+-1"\n+----------|| Import the arrowkdb library ||----------+\n";
+\l q/arrowkdb.q
+
+-1"\n+----------|| Create the schema and data ||----------+\n";
+N:1000
+zc_schema:.arrowkdb.sc.schema (
+  .arrowkdb.fd.field[`i8;.arrowkdb.dt.int8[]];
+  .arrowkdb.fd.field[`u8;.arrowkdb.dt.uint8[]];
+  .arrowkdb.fd.field[`i16;.arrowkdb.dt.int16[]];
+  .arrowkdb.fd.field[`u16;.arrowkdb.dt.uint16[]];
+  .arrowkdb.fd.field[`i32;.arrowkdb.dt.int32[]];
+  .arrowkdb.fd.field[`u32;.arrowkdb.dt.uint32[]];
+  .arrowkdb.fd.field[`i64;.arrowkdb.dt.int64[]];
+  .arrowkdb.fd.field[`u64;.arrowkdb.dt.uint64[]];
+  .arrowkdb.fd.field[`f32;.arrowkdb.dt.float32[]];
+  .arrowkdb.fd.field[`f64;.arrowkdb.dt.float64[]]);
+zc_data:(N?0x00;N?0x00;N?100h;N?100h;N?100i;N?100i;N?100;N?100;N?100e;N?100f);
+zc_copy:zc_data;
+zc_refs:(-16!)each zc_data;
+
+-1"\n+----------|| Wrapped kdb lists are written unchanged ||----------+\n";
+zc_serialized:.arrowkdb.ipc.serializeArrow[zc_schema;zc_data;::];
+zc_data~.arrowkdb.ipc.parseArrowData[zc_serialized;::]
+zc_data~zc_copy
+zc_refs~(-16!)each zc_data
+
+-1"\n+----------|| Chunks wrap slices of the kdb lists ||----------+\n";
+zc_serialized:.arrowkdb.ipc.serializeArrow[zc_schema;zc_data;(``ARROW_CHUNK_ROWS)!(::;300)];
+zc_data~.arrowkdb.ipc.parseArrowData[zc_serialized;::]
+zc_refs~(-16!)each zc_data
+
+-1"\n+----------|| Null mapping is applied as a separate bitmap ||----------+\n";
+zc_data[6;0 1]:7;
+zc_data[9;2 3]:0n;
+zc_data[8;4]:1.5e;
+zc_options:(``NULL_MAPPING)!(::;`int64`float32`float64!(7;1.5e;0n));
+zc_bitmap:zc_options,(enlist`WITH_NULL_BITMAP)!enlist 1;
+zc_serialized:.arrowkdb.ipc.serializeArrow[zc_schema;zc_data;zc_options];
+zc_data~.arrowkdb.ipc.parseArrowData[zc_serialized;zc_options]
+zc_nulls:last .arrowkdb.ipc.parseArrowData[zc_serialized;zc_bitmap];
+(7=zc_data 6)~zc_nulls 6
+(1.5e=zc_data 8)~zc_nulls 8
+(null zc_data 9)~zc_nulls 9
+zc_serialized:.arrowkdb.ipc.serializeArrow[zc_schema;zc_data;zc_options,(enlist`ARROW_CHUNK_ROWS)!enlist 301];
+zc_nulls~last .arrowkdb.ipc.parseArrowData[zc_serialized;zc_bitmap]
+
+-1 "\n+----------|| Test utils ||----------+\n";
+
+.arrowkdb.util.buildInfo[]
+(type .arrowkdb.util.buildInfo[])~99h
+
+
+-1 "\n+----------|| Finished testing ||----------+\n";
@@ -7,8 +7,15 @@ if [[ "$TRAVIS_OS_NAME" == "linux" ]]; then
   wget https://apache.jfrog.io/artifactory/arrow/$(lsb_release --id --short | tr 'A-Z' 'a-z')/apache-arrow-apt-source-latest-$(lsb_release --codename --short).deb
   sudo apt install -y -V ./apache-arrow-apt-source-latest-$(lsb_release --codename --short).deb
   sudo apt update
-  sudo apt install -y -V libarrow-dev=9.0.0-1
-  sudo apt install -y -V libparquet-dev=9.0.0-1
+  # ARROW_VERSION is set by the jobs which build against a newer libarrow
+  ARROW_VERSION=${ARROW_VERSION:-9.0.0-1}
+  sudo apt install -y -V libarrow-dev=$ARROW_VERSION
+  sudo apt install -y -V libparquet-dev=$ARROW_VERSION
+  # ARROW_DATASET is set by the jobs which also test pq.readParquetDataset,
+  # the others test the build without arrow dataset support
+  if [[ -n "$ARROW_DATASET" ]]; then
+    sudo apt install -y -V libarrow-dataset-dev=$ARROW_VERSION
+  fi
 elif [[ "$TRAVIS_OS_NAME" == "osx" ]]; then
   brew install apache-arrow
   mkdir -p cbuild/install